@@ -0,0 +1,74 @@
+// Micro benchmark of ByteScan::find_byte against memchr and a plain loop.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++11 -Isrc bench/byte-scan.cc src/byte_scan.cc -o byte-scan
+//   ./byte-scan
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "byte_scan.h"
+
+static const char *find_byte_loop(const char *data, std::size_t length, char byte)
+{
+    for (std::size_t i = 0; i < length; i++)
+    {
+        if (data[i] == byte)
+        {
+            return data + i;
+        }
+    }
+    return nullptr;
+}
+
+template <typename Find>
+static void bench(const char *name, const std::vector<char> &data, std::size_t line_length, Find find)
+{
+    const int rounds = 200;
+    std::size_t lines = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < rounds; round++)
+    {
+        auto position = data.data();
+        auto end = data.data() + data.size();
+        while (position < end)
+        {
+            auto found = find(position, end - position, '\n');
+            if (found == nullptr)
+            {
+                break;
+            }
+            lines += 1;
+            position = found + 1;
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    auto gigabytes = static_cast<double>(data.size()) * rounds / 1e9;
+    printf("%-10s line length %5zu: %7.2f GB/s (%zu lines)\n", name, line_length, gigabytes / elapsed.count(), lines);
+}
+
+int main()
+{
+    const std::size_t size = 16 * 1024 * 1024;
+    const std::size_t line_lengths[] = {16, 80, 1024, 16384};
+
+    for (auto line_length : line_lengths)
+    {
+        std::vector<char> data(size, 'x');
+        for (std::size_t i = line_length - 1; i < size; i += line_length)
+        {
+            data[i] = '\n';
+        }
+
+        bench("ByteScan", data, line_length, ByteScan::find_byte);
+        bench("memchr", data, line_length, [](const char *d, std::size_t l, char b) {
+            return static_cast<const char *>(memchr(d, b, l));
+        });
+        bench("loop", data, line_length, find_byte_loop);
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+/* eslint-disable no-console */
+import { SocketClientTCP, SocketServerTCP } from "../lib";
+
+const port = 45_000;
+const batchBytes = 64 * 1024;
+const totalBytes = 64 * 1024 * 1024;
+
+/**
+ * Splits lines out of received Buffers in JS, as callers had to before
+ * receiveLines existed.
+ */
+class JSLineSplitter {
+    private pending = Buffer.alloc(0);
+
+    /**
+     * Adds a received chunk, splitting out any lines it completes.
+     *
+     * @param chunk - The Buffer just received.
+     * @returns The complete lines, without their terminators.
+     */
+    public push(chunk: Buffer): string[] {
+        const data = this.pending.length
+            ? Buffer.concat([this.pending, chunk])
+            : chunk;
+        const lines: string[] = [];
+        let start = 0;
+        let newline = data.indexOf(10, start);
+        while (newline !== -1) {
+            const end = data[newline - 1] === 13 ? newline - 1 : newline;
+            lines.push(data.toString("utf8", start, end));
+            start = newline + 1;
+            newline = data.indexOf(10, start);
+        }
+        this.pending = data.slice(start);
+        return lines;
+    }
+}
+
+/**
+ * Sends totalBytes of lines, calling read after every batch until the whole
+ * batch has been read back as lines.
+ *
+ * @param name - The name of this benchmark run.
+ * @param lineLength - The length of each line, including its terminator.
+ * @param read - Reads lines from the client, returning how many were read.
+ */
+function run(
+    name: string,
+    lineLength: number,
+    read: (client: SocketClientTCP) => number,
+): void {
+    const server = new SocketServerTCP(port);
+    const client = new SocketClientTCP(port, "localhost");
+    const sender = server.accept();
+    if (!sender) {
+        throw new Error("Could not accept benchmark client");
+    }
+
+    const line = `${"x".repeat(lineLength - 1)}\n`;
+    const batch = Buffer.from(line.repeat(Math.floor(batchBytes / lineLength)));
+    const linesPerBatch = batch.length / lineLength;
+
+    const start = process.hrtime.bigint();
+    for (let sent = 0; sent < totalBytes; sent += batch.length) {
+        sender.send(batch);
+        let lines = 0;
+        while (lines < linesPerBatch) {
+            lines += read(client);
+        }
+    }
+    const seconds = Number(process.hrtime.bigint() - start) / 1e9;
+
+    console.log(
+        `${name.padEnd(24)} line length ${String(lineLength).padStart(5)}: ${(
+            totalBytes /
+            1e6 /
+            seconds
+        ).toFixed(1)} MB/s`,
+    );
+
+    sender.disconnect();
+    client.disconnect();
+    server.disconnect();
+}
+
+for (const lineLength of [16, 80, 1024]) {
+    run("receiveLines", lineLength, (client) => {
+        const lines = client.receiveLines();
+        return lines ? lines.length : 0;
+    });
+
+    const splitter = new JSLineSplitter();
+    run("receive + JS split", lineLength, (client) => {
+        const chunk = client.receive();
+        return chunk ? splitter.push(chunk).length : 0;
+    });
+}
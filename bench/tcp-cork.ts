@@ -0,0 +1,104 @@
+/* eslint-disable no-console */
+import { readFileSync } from "fs";
+import { SocketClientTCP, SocketServerTCP } from "../lib";
+
+const port = 45_020;
+const writesPerResponse = 64;
+const totalResponses = 4 * 1024;
+
+/**
+ * Reads the number of TCP segments this host has sent, from Linux's
+ * /proc/net/snmp. Counts every connection, including the receiving end's
+ * acknowledgements over loopback, so other traffic adds noise.
+ *
+ * @returns The segments sent so far, or undefined when not on Linux.
+ */
+function segmentsSent(): number | undefined {
+    try {
+        const lines = readFileSync("/proc/net/snmp", "utf8")
+            .split("\n")
+            .filter((line) => line.startsWith("Tcp:"));
+        const names = lines[0].split(" ");
+        const values = lines[1].split(" ");
+        return Number(values[names.indexOf("OutSegs")]);
+    } catch {
+        return undefined;
+    }
+}
+
+/**
+ * Sends totalResponses responses, each built from many small writes, reading
+ * every response back before sending the next. Logs the throughput achieved
+ * and the segments it took.
+ *
+ * @param name - The name of this benchmark run.
+ * @param writeSize - The size of each small write.
+ * @param respond - Sends one response as writesPerResponse writes of chunk.
+ */
+function run(
+    name: string,
+    writeSize: number,
+    respond: (sender: SocketClientTCP, chunk: Buffer) => void,
+): void {
+    const server = new SocketServerTCP(port);
+    const client = new SocketClientTCP(port, "localhost");
+    const sender = server.accept();
+    if (!sender) {
+        throw new Error("Could not accept benchmark client");
+    }
+
+    const chunk = Buffer.alloc(writeSize, "x");
+    const into = Buffer.alloc(writeSize * writesPerResponse);
+
+    const segmentsBefore = segmentsSent();
+    const start = process.hrtime.bigint();
+    for (let responses = 0; responses < totalResponses; responses++) {
+        respond(sender, chunk);
+        let received = 0;
+        while (received < into.length) {
+            received += client.receiveInto(into, received) || 0;
+        }
+    }
+    const seconds = Number(process.hrtime.bigint() - start) / 1e9;
+    const segmentsAfter = segmentsSent();
+
+    const bytes = totalResponses * into.length;
+    const segments =
+        segmentsBefore === undefined || segmentsAfter === undefined
+            ? "n/a"
+            : ((segmentsAfter - segmentsBefore) / totalResponses).toFixed(1);
+    console.log(
+        `${name.padEnd(20)} write size ${String(writeSize).padStart(5)}: ${(
+            bytes /
+            1e6 /
+            seconds
+        ).toFixed(1)} MB/s, ${segments} segments per response`,
+    );
+
+    sender.disconnect();
+    client.disconnect();
+    server.disconnect();
+}
+
+for (const writeSize of [16, 128, 1024]) {
+    run("send each", writeSize, (sender, chunk) => {
+        for (let i = 0; i < writesPerResponse; i++) {
+            sender.send(chunk);
+        }
+    });
+
+    run("send each, more", writeSize, (sender, chunk) => {
+        for (let i = 1; i < writesPerResponse; i++) {
+            sender.send(chunk, { more: true });
+        }
+        sender.send(chunk);
+    });
+
+    run("corked", writeSize, (sender, chunk) => {
+        sender.cork();
+        for (let i = 0; i < writesPerResponse; i++) {
+            sender.send(chunk);
+        }
+        sender.uncork();
+    });
+}
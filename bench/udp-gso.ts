@@ -0,0 +1,70 @@
+/* eslint-disable no-console */
+import { SocketUDP } from "../lib";
+
+const senderPort = 45_010;
+const receiverPort = 45_011;
+const datagramsPerBatch = 64;
+const totalDatagrams = 256 * 1024;
+
+/**
+ * Sends totalDatagrams loopback datagrams in batches, draining the receiver
+ * after every batch, and logs the datagrams per second achieved.
+ *
+ * @param name - The name of this benchmark run.
+ * @param datagramSize - The size of each datagram.
+ * @param gro - If the receiver should have generic receive offload enabled.
+ * @param send - Sends one batch of datagrams to the receiver.
+ */
+function run(
+    name: string,
+    datagramSize: number,
+    gro: boolean,
+    send: (sender: SocketUDP, batch: Buffer) => void,
+): void {
+    const sender = new SocketUDP(senderPort, "localhost");
+    const receiver = new SocketUDP(receiverPort, "localhost");
+    receiver.gro = gro;
+
+    const batch = Buffer.alloc(datagramSize * datagramsPerBatch, "x");
+    const into = Buffer.alloc(64 * 1024);
+
+    const start = process.hrtime.bigint();
+    for (let sent = 0; sent < totalDatagrams; sent += datagramsPerBatch) {
+        send(sender, batch);
+        let received = 0;
+        while (received < batch.length) {
+            const read = receiver.receiveFromInto(into);
+            received += read ? read.bytesRead : 0;
+        }
+    }
+    const seconds = Number(process.hrtime.bigint() - start) / 1e9;
+
+    console.log(
+        `${name.padEnd(32)} datagram size ${String(datagramSize).padStart(
+            5,
+        )}: ${(totalDatagrams / 1e3 / seconds).toFixed(1)}k pps`,
+    );
+
+    sender.disconnect();
+    receiver.disconnect();
+}
+
+for (const datagramSize of [64, 512, 1200]) {
+    run("sendTo each, no GRO", datagramSize, false, (sender, batch) => {
+        for (let i = 0; i < batch.length; i += datagramSize) {
+            sender.sendTo(
+                "localhost",
+                receiverPort,
+                batch.slice(i, i + datagramSize),
+            );
+        }
+    });
+
+    run("sendToSegmented, no GRO", datagramSize, false, (sender, batch) => {
+        sender.sendToSegmented("localhost", receiverPort, batch, datagramSize);
+    });
+
+    run("sendToSegmented, GRO", datagramSize, true, (sender, batch) => {
+        sender.sendToSegmented("localhost", receiverPort, batch, datagramSize);
+    });
+}
@@ -3,13 +3,21 @@
     {
       "target_name": "netlinksocket",
       "sources": [
+        "src/address_cache.cc",
+        "src/buffer_pool.cc",
+        "src/byte_scan.cc",
+        "src/connect_worker.cc",
+        "src/endpoint.cc",
         "src/netlinksocket.cc",
         "src/netlinkwrapper.cc",
         "src/netlink/core.cc",
+        "src/netlink/resolver.cc",
         "src/netlink/smart_buffer.cc",
         "src/netlink/socket.cc",
         "src/netlink/socket_group.cc",
-        "src/netlink/util.cc"
+        "src/netlink/util.cc",
+        "src/resolver_wrapper.cc",
+        "src/string_decode.cc"
       ],
       "cflags": [ "-fexceptions" ],
       "cflags_cc": [ "-fexceptions" ],
@@ -51,6 +51,146 @@ export declare abstract class SocketBase {
     readonly isIPv6: boolean;
 }
 
+/**
+ * An opt-in pool of memory that received Buffers are carved out of, to
+ * avoid allocating new memory for every receive. Assign it to the
+ * `bufferPool` property of one or more sockets to use it.
+ *
+ * Memory is allocated in large slabs. Once every Buffer carved from a slab is
+ * either passed to `release()` or garbage collected the slab is recycled.
+ */
+export declare class BufferPool {
+    /**
+     * Creates a new BufferPool.
+     *
+     * @param slabSize - The size in bytes of each slab of memory. Received
+     * data larger than this is not pooled. Defaults to 64 KiB.
+     * @param highWaterMark - The maximum number of bytes of unused slabs
+     * kept around for re-use, beyond this they are freed. Defaults to 1 MiB.
+     */
+    constructor(slabSize?: number, highWaterMark?: number);
+
+    /**
+     * Explicitly releases a Buffer received from this pool, so its memory can
+     * be re-used without waiting for garbage collection. **Note**: The Buffer
+     * must not be used after being released.
+     *
+     * @param buffer - A Buffer returned from a receive call of a socket
+     * using this pool.
+     * @returns True if the Buffer was released. False if it was not from this
+     * pool (such as when it was too large to fit in a slab), is only a slice
+     * of one, or was already released.
+     */
+    release(buffer: Buffer): boolean;
+
+    /**
+     * The size in bytes of each slab of memory.
+     */
+    readonly slabSize: number;
+
+    /**
+     * The maximum number of bytes of unused slabs kept for re-use.
+     */
+    readonly highWaterMark: number;
+
+    /**
+     * The number of received Buffers carved from an already allocated slab.
+     */
+    readonly hits: number;
+
+    /**
+     * The number of received Buffers that required allocating memory, either
+     * a new slab or a non pooled Buffer that was too large for a slab.
+     */
+    readonly misses: number;
+
+    /**
+     * The number of bytes of received Buffers that have not yet been released
+     * or garbage collected.
+     */
+    readonly bytesInFlight: number;
+}
+
+/**
+ * A host and port resolved once, up front. Pass it in place of a host and
+ * port to `SocketUDP` sends, so they skip parsing and resolving the host and
+ * port on every call.
+ */
+export declare class Endpoint {
+    /**
+     * Creates a new Endpoint, resolving the host right away.
+     *
+     * @param host - The host name or address to send to.
+     * @param port - The port number to send to.
+     * @param ipVersion - The IP version to resolve the host to, which must
+     * match the sockets sending to it. Defaults to 'IPv4'.
+     */
+    constructor(host: string, port: number, ipVersion?: "IPv4" | "IPv6");
+
+    /**
+     * The address the host resolved to.
+     */
+    readonly host: string;
+
+    /**
+     * The port number to send to.
+     */
+    readonly port: number;
+
+    /**
+     * Flag if the address is Internet Protocol Version 4 (IPv4).
+     */
+    readonly isIPv4: boolean;
+
+    /**
+     * Flag if the address is Internet Protocol Version 6 (IPv6).
+     */
+    readonly isIPv6: boolean;
+}
+
+/**
+ * The resolver every socket resolves its hosts through, shared by the whole
+ * process.
+ *
+ * Numeric hosts such as "10.0.0.5" or "::1" are parsed without a DNS lookup.
+ * Resolved names are cached, so repeated `sendTo()` calls and new sockets to
+ * the same host skip the lookup.
+ */
+export declare const resolver: {
+    /**
+     * Gets/sets how many resolved names are cached. Beyond this the least
+     * recently used are evicted. Set to 0 to disable the cache.
+     * Defaults to 256.
+     */
+    cacheSize: number;
+
+    /**
+     * Gets/sets how long resolved names are cached, in milliseconds. Names
+     * already cached keep their expiry. Defaults to 30 seconds.
+     */
+    cacheTtl: number;
+
+    /**
+     * The number of names served from the cache.
+     */
+    readonly cacheHits: number;
+
+    /**
+     * The number of names looked up as they were not cached, or had expired.
+     */
+    readonly cacheMisses: number;
+
+    /**
+     * The number of numeric hosts parsed without a lookup.
+     */
+    readonly numericHits: number;
+
+    /**
+     * Forgets every cached name, so each is looked up again on next use.
+     */
+    clearCache(): void;
+};
+
 /**
  * Represents a TCP Client connection.
  */
@@ -62,37 +202,364 @@ export declare class SocketClientTCP extends SocketBase {
      * @param portTo - The host of the address to connect this TCP client to.
      * @param hostTo - The host of the address to connect this TCP client to.
      * @param ipVersion - An optional specific IP version to use. Defaults to
+     * IPv4. "any" connects over whichever version connects first.
+     * @param connectTimeout - An optional number of milliseconds to wait at
+     * most to connect, across every address the host resolves to. Defaults to
+     * 0, which waits as long as the operating system does.
+     * @param connectStagger - An optional number of milliseconds each address
+     * the host resolves to gets to connect before the next one is also tried,
+     * alternating between IP versions. The first to connect is kept, as in
+     * RFC 8305 ("Happy Eyeballs"). Defaults to 250.
+     */
+    constructor(
+        portTo: number,
+        hostTo: string,
+        ipVersion?: "IPv4" | "IPv6" | "any",
+        connectTimeout?: number,
+        connectStagger?: number,
+    );
+
+    /**
+     * Resolves the address and connects to it off the main thread, so
+     * neither the lookup nor the handshake blocks the event loop.
+     *
+     * **Note**: Each pending connect occupies a worker of libuv's thread pool
+     * (4 by default, see `UV_THREADPOOL_SIZE`), which is shared with `fs`,
+     * `dns.lookup()`, `crypto`, and `zlib`. So connects to unresponsive
+     * hosts can delay that work until they time out.
+     *
+     * @param portTo - The port of the address to connect this TCP client to.
+     * @param hostTo - The host of the address to connect this TCP client to.
+     * @param ipVersion - An optional specific IP version to use. Defaults to
      * IPv4.
+     * @param connectTimeout - An optional number of milliseconds to wait at
+     * most to connect. Defaults to 30000. 0 waits as long as the operating
+     * system does, which can be minutes.
+     * @param connectStagger - An optional number of milliseconds each address
+     * gets to connect before the next one is also tried. Defaults to 250.
+     * @returns A promise resolving to the connected client, or rejecting with
+     * an Error if no connection could be made.
      */
-    constructor(portTo: number, hostTo: string, ipVersion?: "IPv4" | "IPv6");
+    static connect(
+        portTo: number,
+        hostTo: string,
+        ipVersion?: "IPv4" | "IPv6" | "any",
+        connectTimeout?: number,
+        connectStagger?: number,
+    ): Promise<SocketClientTCP>;
 
     /**
      * The target host of the socket.
      */
     readonly hostTo: string;
 
+    /**
+     * An optional BufferPool that Buffers returned from receive calls are
+     * carved out of. Set to undefined (the default) to allocate a new Buffer
+     * for each receive instead.
+     */
+    bufferPool: BufferPool | undefined;
+
     /**
      * The port this socket is connected/sends to.
      */
     readonly portTo: number;
 
+    /**
+     * Gets/sets the capacity in bytes of this socket's read-ahead buffer.
+     * 0 (the default) means read-ahead is disabled.
+     *
+     * When enabled, receives asking for fewer bytes than this are served from
+     * memory, which is refilled with a single large read from the operating
+     * system once empty. This saves a system call per small receive.
+     * Setting it lower than the amount of data currently buffered throws an
+     * Error.
+     *
+     * This sizes only the socket's read-ahead. Data that `receiveMessages()`,
+     * `receiveUntil()`, or `receiveLines()` read but did not return yet is
+     * buffered separately, and is returned by `receive()` before anything
+     * still on the socket.
+     */
+    readAhead: number;
+
+    /**
+     * The total number of bytes served to receive calls from the read-ahead
+     * buffer.
+     */
+    readonly readAheadBytesServed: number;
+
+    /**
+     * The total number of times the read-ahead buffer was refilled from the
+     * operating system.
+     */
+    readonly readAheadRefills: number;
+
+    /**
+     * If sends of large Buffers are made without copying them into the
+     * operating system (`MSG_ZEROCOPY`). Only supported on Linux, enabling it
+     * elsewhere throws an Error. Defaults to false.
+     *
+     * Once a Buffer has been sent this way the operating system keeps reading
+     * from its memory, so it must not be modified until `zeroCopyCompleted`
+     * reaches the `zeroCopySent` value read right after sending it. Strings
+     * and arrays of data are always safe to send.
+     */
+    zeroCopy: boolean;
+
+    /**
+     * The number of bytes below which sends are copied, even when `zeroCopy`
+     * is enabled, as pinning the memory of small sends costs more than
+     * copying it. Defaults to 65536.
+     */
+    zeroCopyThreshold: number;
+
+    /**
+     * The total number of system calls that sent data without copying it.
+     */
+    readonly zeroCopySent: number;
+
+    /**
+     * The total number of zero copy sends the operating system is done with.
+     * Completions are in order, so the memory of the first `n` zero copy
+     * sends may be reused once this reaches `n`.
+     */
+    readonly zeroCopyCompleted: number;
+
+    /**
+     * The total number of completed zero copy sends the operating system had
+     * to copy anyway, such as those over loopback. If most sends are copied
+     * `zeroCopy` only adds overhead.
+     */
+    readonly zeroCopyCopied: number;
+
     /**
      * Attempts to Receive data from the server and return it as a Buffer.
      *
-     * @returns A Buffer instance with the data read from the connected server.
+     * The read is sized from the data already queued on the socket, so it
+     * normally completes in a single system call.
+     *
+     * @param maxBytes - An optional upper bound on the number of bytes to
+     * read in this call. Any remaining data is left on the socket for the
+     * next call. Defaults to no bound, reading everything queued.
+     * @returns A Buffer instance with the data read from the connected server,
+     * its `length` being the number of bytes read.
      * If set to blocking this call will synchronously block until some data
      * is received. Otherwise if there is no data to receive, this will return
      * undefined immediately and not block.
      */
-    receive(): Buffer | undefined;
+    receive(maxBytes?: number): Buffer | undefined;
+
+    /**
+     * Attempts to Receive data from the server directly into an existing
+     * Buffer or Uint8Array, without allocating a new Buffer.
+     *
+     * @param buffer - The Buffer or Uint8Array to write received data into.
+     * @param offset - An optional offset into `buffer` to start writing at.
+     * Defaults to 0.
+     * @param length - An optional maximum number of bytes to write. Defaults
+     * to the rest of `buffer` after `offset`.
+     * @returns The number of bytes written into `buffer`. If set to blocking
+     * this call will synchronously block until some data is received.
+     * Otherwise if there is no data to receive, this will return undefined
+     * immediately and not block.
+     */
+    receiveInto(
+        buffer: Buffer | Uint8Array,
+        offset?: number,
+        length?: number,
+    ): number | undefined;
+
+    /**
+     * Receives data up to a delimiter, such as `"\r\n\r\n"`. Data after the
+     * delimiter is buffered for the next receive call.
+     *
+     * @param delimiter - The delimiter to receive up to. It is consumed, but
+     * not included in the returned data.
+     * @param maxBytes - An optional maximum number of bytes to receive before
+     * the delimiter. If no delimiter is found within it an Error is thrown,
+     * and the data stays buffered. Defaults to no bound.
+     * @returns The data before the delimiter. If set to blocking this call
+     * will synchronously block until the delimiter is received. Otherwise if
+     * the delimiter has not been received, this will return undefined
+     * immediately and not block.
+     */
+    receiveUntil(
+        delimiter: string | Buffer | Uint8Array,
+        maxBytes?: number,
+    ): Buffer | undefined;
+
+    /**
+     * Receives all complete lines, terminated by either `"\n"` or `"\r\n"`.
+     * A trailing partial line is buffered for the next receive call.
+     *
+     * @param maxLines - An optional maximum number of lines to return. Any
+     * others are kept buffered for the next call. Must be greater than 0.
+     * Defaults to no bound.
+     * @param maxBytes - An optional maximum number of bytes in a line before
+     * its terminator. If the first line is not terminated within it an Error
+     * is thrown, and the data stays buffered. Defaults to no bound.
+     * @returns The lines received decoded as UTF-8 strings, without their
+     * terminators. If set to blocking this call will synchronously block until
+     * at least one line is received. Otherwise if there is no complete line,
+     * this will return undefined immediately and not block.
+     */
+    receiveLines(maxLines?: number, maxBytes?: number): string[] | undefined;
+
+    /**
+     * Receives data decoded straight into a string, without first creating a
+     * Buffer. When decoding UTF-8, a multi-byte character cut short by the
+     * end of the data received so far is held back and completed by the next
+     * call.
+     *
+     * @param encoding - The encoding to decode the data as, one of `"utf8"`,
+     * `"latin1"`, or `"ascii"`. Decodes the same as `Buffer.toString()`.
+     * Defaults to `"utf8"`.
+     * @param maxBytes - An optional maximum number of bytes to receive.
+     * Defaults to no bound.
+     * @returns The data received as a string. If set to blocking this call
+     * will synchronously block until some is received. Otherwise if there is
+     * nothing to receive, this will return undefined immediately and not
+     * block.
+     */
+    receiveString(
+        encoding?: "utf8" | "utf-8" | "latin1" | "binary" | "ascii",
+        maxBytes?: number,
+    ): string | undefined;
+
+    /**
+     * Receives all complete length prefixed messages, as set up via
+     * `setFraming()`. Partially received messages are buffered until the rest
+     * of them arrives.
+     *
+     * @param maxMessages - An optional maximum number of messages to return,
+     * greater than 0. Any others are kept buffered for the next call.
+     * Defaults to no bound.
+     * @param compact - When true, returns the messages as a single Buffer of
+     * every payload back to back, with `offsets` holding where each message
+     * starts followed by where the last one ends. Defaults to false, which
+     * returns an array of Buffers, one per message. Either way the Buffers
+     * are carved from the `bufferPool` when one is set.
+     * @returns The complete messages received. If set to blocking this call
+     * will synchronously block until at least one message is received.
+     * Otherwise if there is no complete message, this will return undefined
+     * immediately and not block.
+     */
+    receiveMessages(
+        maxMessages?: number,
+        compact?: false,
+    ): Buffer[] | undefined;
+    receiveMessages(
+        maxMessages: number | undefined,
+        compact: true,
+    ): { data: Buffer; offsets: Int32Array } | undefined;
+
+    /**
+     * Corks the socket, holding sent data back until it fills whole segments
+     * so that many small sends go out together, until `uncork()` is called.
+     * Supported on Linux (`TCP_CORK`), macOS, and the BSDs (`TCP_NOPUSH`),
+     * elsewhere this throws an Error.
+     */
+    cork(): void;
+
+    /**
+     * Uncorks the socket, sending any data held back by `cork()` right away.
+     */
+    uncork(): void;
+
+    /**
+     * If the socket is currently corked via `cork()`.
+     */
+    readonly isCorked: boolean;
 
     /**
      * Sends the data to the connected server.
      *
      * @param data - The data you want to send, as a string, Buffer, or
-     * Uint8Array.
+     * Uint8Array. An array of them is sent back to back, as if concatenated,
+     * using as few system calls as possible (`sendmsg`).
+     * @param options - Optional options for this send.
+     * @param options.more - If more data follows soon, so this is held back
+     * until it fills a whole segment or a send without it follows
+     * (`MSG_MORE`). Only a hint, ignored off Linux. Defaults to false.
+     * @returns The number of bytes sent. Blocking sockets always send
+     * everything, while non-blocking sockets send only what the operating
+     * system accepts without waiting. The rest is queued if `writeQueue` is
+     * enabled, otherwise it is up to the caller to send it again.
+     */
+    send(
+        data:
+            | string
+            | Buffer
+            | Uint8Array
+            | ReadonlyArray<string | Buffer | Uint8Array>,
+        options?: { more?: boolean },
+    ): number;
+
+    /**
+     * If data a non-blocking `send()` could not send right away is queued
+     * natively, to be sent ahead of later data by `flush()` or the next
+     * `send()`. Otherwise it is left to the caller to send again. Disabling
+     * it keeps data already queued. Defaults to false.
+     */
+    writeQueue: boolean;
+
+    /**
+     * The number of bytes queued to be sent, see `writeQueue`. Useful to
+     * apply backpressure without blocking.
+     */
+    readonly writeQueueSize: number;
+
+    /**
+     * Sends as much queued data (see `writeQueue`) as the socket accepts
+     * without waiting, or all of it if blocking.
+     *
+     * @returns The number of bytes still queued, 0 once everything is sent.
+     */
+    flush(): number;
+
+    /**
+     * Sends part of a file to the connected server. On Linux the operating
+     * system moves the data straight from the file to the socket
+     * (`sendfile`), without it ever being copied into memory.
+     *
+     * @param pathOrFd - The path of the file, or a file descriptor open for
+     * reading, such as one from `fs.openSync()`.
+     * @param offset - The position in the file to start sending from.
+     * Defaults to 0.
+     * @param length - The maximum number of bytes to send. Defaults to the
+     * rest of the file.
+     * @returns The number of bytes sent. This is less than `length` at the end
+     * of the file, or when a non-blocking socket could not take more, in
+     * which case the rest can be sent by calling again from `offset` plus
+     * the bytes sent. Nothing is sent while data is queued (see
+     * `writeQueue`).
+     */
+    sendFile(
+        pathOrFd: string | number,
+        offset?: number,
+        length?: number,
+    ): number;
+
+    /**
+     * Sets how messages are length prefixed for `receiveMessages()`.
+     *
+     * @param prefix - The type of the length prefix before each message.
+     * Fixed width unsigned integers either big (`be`) or little (`le`)
+     * endian, `varint` for an unsigned LEB128 varint, or `none` to disable.
+     * @param maxFrameLength - An optional maximum message length in bytes.
+     * Receiving a longer message throws an Error. Defaults to 16 MiB.
      */
-    send(data: string | Buffer | Uint8Array): void;
+    setFraming(
+        prefix:
+            | "none"
+            | "uint8"
+            | "uint16be"
+            | "uint16le"
+            | "uint32be"
+            | "uint32le"
+            | "varint",
+        maxFrameLength?: number,
+    ): void;
 }
 
 /**
@@ -149,11 +616,14 @@ export declare class SocketUDP extends SocketBase {
      * empty string, or "*", then the operating system attempts to bind
      * to all local addresses.
      * @param ipVersion - The IP version to be used. IPv4 by default.
+     * @param connectTo - An optional peer to connect to right away, as
+     * `connect(connectTo.host, connectTo.port)` does.
      */
     constructor(
         portFrom?: number,
         hostFrom?: string,
         ipVersion?: "IPv4" | "IPv6",
+        connectTo?: { host: string; port: number },
     );
 
     /**
@@ -162,12 +632,230 @@ export declare class SocketUDP extends SocketBase {
     readonly hostFrom: string;
 
     /**
-     * Receive data from datagrams and returns the data and their address.
+     * The host of the peer this socket is connected to, if any.
+     */
+    readonly hostTo: string;
+
+    /**
+     * The port of the peer this socket is connected to, if any.
+     */
+    readonly portTo: number;
+
+    /**
+     * Flag if this socket is connected to a peer via `connect()`.
+     */
+    readonly isConnected: boolean;
+
+    /**
+     * Connects this socket to a single peer. The operating system then keeps
+     * its address, so `send()` and `receive()` need none, and datagrams from
+     * any other host are discarded. Errors the peer reports, such as nothing
+     * listening on its port, are thrown by a later `send()` or `receive()`.
+     * Can be called again to connect to another peer.
+     *
+     * @param hostTo - The host string of the peer.
+     * @param portTo - The port number of the peer.
+     */
+    connect(hostTo: string, portTo: number): void;
+
+    /**
+     * Connects this socket to a single, pre-resolved, peer.
+     *
+     * @param endpoint - The Endpoint of the peer.
+     */
+    connect(endpoint: Endpoint): void;
+
+    /**
+     * Sends a datagram to the peer this socket is connected to. Throws if it
+     * is not connected.
+     *
+     * @param data - The data to send. Can be a `string`, `Buffer`, or
+     * `Uint8Array`, or an array of them sent as one datagram.
+     * @returns The number of bytes sent, 0 if a non-blocking socket's send
+     * buffer was full.
+     */
+    send(
+        data:
+            | string
+            | Buffer
+            | Uint8Array
+            | ReadonlyArray<string | Buffer | Uint8Array>,
+    ): number;
+
+    /**
+     * Receives a datagram from the peer this socket is connected to. Throws
+     * if it is not connected, use `receiveFrom()` then.
+     *
+     * @returns The datagram, or undefined if there was none to receive on a
+     * non-blocking socket. `truncated` is true when the datagram was larger
+     * than `maxDatagramSize` and only its start was received. When `gro` is
+     * enabled, `segmentSize` is the size of each datagram coalesced into
+     * `data`.
+     */
+    receive():
+        | { data: Buffer; truncated: boolean; segmentSize?: number }
+        | undefined;
+
+    /**
+     * An optional BufferPool that Buffers returned from receive calls are
+     * carved out of. Set to undefined (the default) to allocate a new Buffer
+     * for each receive instead.
+     */
+    bufferPool: BufferPool | undefined;
+
+    /**
+     * Gets/sets how many source hosts are cached as strings, so datagrams
+     * from repeat peers do not format and allocate a new host string.
+     * Defaults to 1024, 0 disables the cache.
+     */
+    addressCacheSize: number;
+
+    /**
+     * The number of received datagrams whose host string was in the cache.
+     */
+    readonly addressCacheHits: number;
+
+    /**
+     * The number of received datagrams whose host string had to be created.
+     */
+    readonly addressCacheMisses: number;
+
+    /**
+     * Gets/sets if generic receive offload (`UDP_GRO`) is enabled, so the
+     * operating system may coalesce many same size datagrams from one sender
+     * into a single receive. Use `receiveFromInto()` with a buffer of up to
+     * 64 KiB to learn the size of each datagram. `receive()`,
+     * `receiveFrom()`, and `receiveFromInto()` then report `segmentSize`,
+     * and `receiveFromMany()` reports `segmentSizes`. `receiveFromRaw()`
+     * has nowhere to report it, so throws while this is enabled. Only
+     * supported on Linux, enabling it elsewhere throws an Error.
+     */
+    gro: boolean;
+
+    /**
+     * Gets/sets the size in bytes of the largest datagram `receiveFrom()`
+     * receives whole, up to 65536. Larger datagrams are truncated to this
+     * size. Defaults to 65507, the largest possible IPv4 UDP payload.
+     */
+    maxDatagramSize: number;
+
+    /**
+     * Receive a single datagram and returns the data and its address.
      *
      * @returns An object, containing the key `data` as a Buffer of the received
-     * data. The address is present as key `host` and key `port`.
+     * data. The address is present as key `host` and key `port`. The key
+     * `truncated` is true if the datagram was larger than `maxDatagramSize`,
+     * in which case the rest of it was discarded. When `gro` is enabled, the
+     * key `segmentSize` is the size of each datagram coalesced into `data`.
+     */
+    receiveFrom():
+        | {
+              host: string;
+              port: number;
+              data: Buffer;
+              truncated: boolean;
+              segmentSize?: number;
+          }
+        | undefined;
+
+    /**
+     * Receive a single datagram decoded straight into a string, and its
+     * address.
+     *
+     * @param encoding - The encoding to decode the datagram as, one of
+     * `"utf8"`, `"latin1"`, or `"ascii"`.
+     * @returns The same as `receiveFrom()`, but with `data` as a string.
      */
-    receiveFrom(): { host: string; port: number; data: Buffer } | undefined;
+    receiveFrom(
+        encoding: "utf8" | "utf-8" | "latin1" | "binary" | "ascii",
+    ):
+        | {
+              host: string;
+              port: number;
+              data: string;
+              truncated: boolean;
+              segmentSize?: number;
+          }
+        | undefined;
+
+    /**
+     * Receive a datagram directly into an existing Buffer or Uint8Array,
+     * without allocating a new Buffer.
+     *
+     * @param buffer - The Buffer or Uint8Array to write the datagram into.
+     * @param offset - An optional offset into `buffer` to start writing at.
+     * Defaults to 0.
+     * @param length - An optional maximum number of bytes to write. Defaults
+     * to the rest of `buffer` after `offset`.
+     * @returns An object, containing the key `bytesRead` as the number of
+     * bytes written into `buffer`. The address is present as key `host` and
+     * key `port`. The key `truncated` is true if the datagram did not fit,
+     * in which case the rest of it was discarded. When `gro` is enabled, the
+     * key `segmentSize` is the size of each datagram coalesced into the bytes
+     * read, only the last of which may be shorter.
+     */
+    receiveFromInto(
+        buffer: Buffer | Uint8Array,
+        offset?: number,
+        length?: number,
+    ):
+        | {
+              host: string;
+              port: number;
+              bytesRead: number;
+              truncated: boolean;
+              segmentSize?: number;
+          }
+        | undefined;
+
+    /**
+     * Receives a datagram into an existing Buffer, writing where it came from
+     * into an existing Uint32Array instead of allocating any objects or
+     * strings. Reusing the same `buffer` and `info` makes receive loops
+     * allocation free.
+     *
+     * @param buffer - The Buffer or Uint8Array to write the datagram into.
+     * @param info - A Uint32Array of at least 7 elements to write the
+     * datagram's info into: `[port, ipVersion, truncated, ...address]`.
+     * `ipVersion` is 4 or 6, and `truncated` is 1 if the datagram did not fit
+     * in `buffer`, otherwise 0. The address is the last 4 elements as big
+     * endian words, so an IPv4 address is the single number `info[3]`, e.g.
+     * `0x7F000001` for 127.0.0.1, and the rest are 0.
+     * @returns The number of bytes written into `buffer`, or -1 if there was
+     * nothing to receive. Throws if `gro` is enabled.
+     */
+    receiveFromRaw(buffer: Buffer | Uint8Array, info: Uint32Array): number;
+
+    /**
+     * Receives many datagrams at once, using a single `recvmmsg` system call
+     * on Linux. Blocking sockets wait for the first datagram only.
+     *
+     * @param maxDatagrams - The maximum number of datagrams to receive.
+     * @param bufferSize - The maximum size of each datagram, larger ones are
+     * truncated.
+     * @returns An object, containing the key `data` as a Buffer of every
+     * datagram back to back. Datagram `i` starts at `offsets[i]` and is
+     * `lengths[i]` bytes long, `offsets` has an extra trailing entry of the
+     * total length. It was sent from port `ports[i]` of host
+     * `addresses[addressIndices[i]]`, each distinct host appears once in
+     * `addresses`. When `gro` is enabled, `segmentSizes[i]` is the size of
+     * each datagram coalesced into datagram `i`. Returns undefined if there
+     * is nothing to receive.
+     */
+    receiveFromMany(
+        maxDatagrams: number,
+        bufferSize: number,
+    ):
+        | {
+              data: Buffer;
+              offsets: Int32Array;
+              lengths: Int32Array;
+              ports: Uint16Array;
+              addressIndices: Uint32Array;
+              addresses: string[];
+              segmentSizes?: Int32Array;
+          }
+        | undefined;
 
     /**
      * Sends to a specific datagram address some data.
@@ -175,11 +863,122 @@ export declare class SocketUDP extends SocketBase {
      * @param hostTo - The host string to send data to.
      * @param portTo - The port number to send data to.
      * @param data - The actual data payload to send. Can be a `string`,
-     * `Buffer`, or `Uint8Array`.
+     * `Buffer`, or `Uint8Array`. An array of them is sent as one datagram of
+     * their concatenation, without copying them together (`sendmsg`).
+     */
+    sendTo(
+        hostTo: string,
+        portTo: number,
+        data:
+            | string
+            | Buffer
+            | Uint8Array
+            | ReadonlyArray<string | Buffer | Uint8Array>,
+    ): void;
+
+    /**
+     * Sends to a pre-resolved Endpoint some data. The Endpoint must be of the
+     * same IP version as this socket.
+     *
+     * @param endpoint - The Endpoint to send data to.
+     * @param data - The actual data payload to send. Can be a `string`,
+     * `Buffer`, or `Uint8Array`, or an array of them sent as one datagram.
      */
     sendTo(
+        endpoint: Endpoint,
+        data:
+            | string
+            | Buffer
+            | Uint8Array
+            | ReadonlyArray<string | Buffer | Uint8Array>,
+    ): void;
+
+    /**
+     * Sends data as many datagrams of the same size, the last of which may be
+     * shorter. On Linux the operating system splits the data (`UDP_SEGMENT`),
+     * so up to 64 datagrams are sent per system call.
+     *
+     * @param hostTo - The host string to send data to.
+     * @param portTo - The port number to send data to.
+     * @param data - The data payload to split into datagrams. Can be a
+     * `string`, `Buffer`, or `Uint8Array`.
+     * @param segmentSize - The size of each datagram.
+     */
+    sendToSegmented(
         hostTo: string,
         portTo: number,
         data: string | Buffer | Uint8Array,
+        segmentSize: number,
+    ): void;
+
+    /**
+     * Sends data as many datagrams of the same size to a pre-resolved
+     * Endpoint, as `sendToSegmented(hostTo, portTo, data, segmentSize)` does.
+     *
+     * @param endpoint - The Endpoint to send data to.
+     * @param data - The data payload to split into datagrams. Can be a
+     * `string`, `Buffer`, or `Uint8Array`.
+     * @param segmentSize - The size of each datagram.
+     */
+    sendToSegmented(
+        endpoint: Endpoint,
+        data: string | Buffer | Uint8Array,
+        segmentSize: number,
     ): void;
+
+    /**
+     * Sends many datagrams at once, using a single `sendmmsg` system call on
+     * Linux. Each distinct destination is only resolved once per call.
+     *
+     * @param messages - The datagrams to send, each with the `host` and
+     * `port`, or the pre-resolved `endpoint`, to send its `data` to.
+     * @returns The number of datagrams accepted by the operating system,
+     * which may be fewer than given if a non-blocking socket's send buffer
+     * fills up.
+     */
+    sendToMany(
+        messages: (
+            | {
+                  host: string;
+                  port: number;
+                  data: string | Buffer | Uint8Array;
+              }
+            | {
+                  endpoint: Endpoint;
+                  data: string | Buffer | Uint8Array;
+              }
+        )[],
+    ): number;
+
+    /**
+     * Sends many datagrams at once to the same address, using a single
+     * `sendmmsg` system call on Linux.
+     *
+     * @param hostTo - The host string to send every payload to.
+     * @param portTo - The port number to send every payload to.
+     * @param payloads - The data of each datagram to send.
+     * @returns The number of datagrams accepted by the operating system,
+     * which may be fewer than given if a non-blocking socket's send buffer
+     * fills up.
+     */
+    sendToMany(
+        hostTo: string,
+        portTo: number,
+        payloads: (string | Buffer | Uint8Array)[],
+    ): number;
+
+    /**
+     * Sends many datagrams at once to the same pre-resolved Endpoint, using a
+     * single `sendmmsg` system call on Linux.
+     *
+     * @param endpoint - The Endpoint to send every payload to.
+     * @param payloads - The data of each datagram to send.
+     * @returns The number of datagrams accepted by the operating system,
+     * which may be fewer than given if a non-blocking socket's send buffer
+     * fills up.
+     */
+    sendToMany(
+        endpoint: Endpoint,
+        payloads: (string | Buffer | Uint8Array)[],
+    ): number;
 }
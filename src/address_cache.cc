@@ -0,0 +1,108 @@
+#include <cstring>
+#include <iterator>
+#include <nan.h>
+#include "address_cache.h"
+#include "netlinkwrapper.h"
+
+bool AddressCache::Key::operator==(const Key &other) const
+{
+    return this->family == other.family &&
+           this->scope_id == other.scope_id &&
+           memcmp(this->bytes, other.bytes, sizeof(this->bytes)) == 0;
+}
+
+std::size_t AddressCache::KeyHash::operator()(const Key &key) const
+{
+    // FNV-1a, addresses are short so this is plenty
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const unsigned char *data, std::size_t length) {
+        for (std::size_t i = 0; i < length; i++)
+        {
+            hash ^= data[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    mix(key.bytes, sizeof(key.bytes));
+    mix(reinterpret_cast<const unsigned char *>(&key.family), sizeof(key.family));
+    mix(reinterpret_cast<const unsigned char *>(&key.scope_id), sizeof(key.scope_id));
+    return static_cast<std::size_t>(hash);
+}
+
+AddressCache::Key AddressCache::key_of(const struct sockaddr_storage &address)
+{
+    Key key;
+    key.family = address.ss_family;
+    if (address.ss_family == AF_INET)
+    {
+        auto in = reinterpret_cast<const struct sockaddr_in *>(&address);
+        memcpy(key.bytes, &in->sin_addr, sizeof(in->sin_addr));
+    }
+    else if (address.ss_family == AF_INET6)
+    {
+        auto in6 = reinterpret_cast<const struct sockaddr_in6 *>(&address);
+        memcpy(key.bytes, &in6->sin6_addr, sizeof(in6->sin6_addr));
+        key.scope_id = in6->sin6_scope_id;
+    }
+
+    return key;
+}
+
+AddressCache::AddressCache(std::size_t capacity)
+{
+    this->max_entries = capacity;
+}
+
+v8::Local<v8::String> AddressCache::host(const struct sockaddr_storage &address)
+{
+    auto isolate = v8::Isolate::GetCurrent();
+    if (this->max_entries == 0)
+    {
+        return v8_str(NL::Socket::hostFromAddress(address));
+    }
+
+    auto key = AddressCache::key_of(address);
+    auto found = this->lookup.find(key);
+    if (found != this->lookup.end())
+    {
+        this->hits += 1;
+        // move to the front, this does not allocate
+        this->entries.splice(this->entries.begin(), this->entries, found->second);
+        return found->second->host.Get(isolate);
+    }
+
+    this->misses += 1;
+    auto host = v8_str(NL::Socket::hostFromAddress(address));
+    if (this->entries.size() >= this->max_entries)
+    {
+        // reuse the least recently used entry for this one
+        auto last = std::prev(this->entries.end());
+        this->lookup.erase(last->key);
+        this->entries.splice(this->entries.begin(), this->entries, last);
+    }
+    else
+    {
+        this->entries.emplace_front();
+    }
+
+    auto &entry = this->entries.front();
+    entry.key = key;
+    entry.host.Reset(isolate, host);
+    this->lookup[key] = this->entries.begin();
+    return host;
+}
+
+std::size_t AddressCache::capacity() const
+{
+    return this->max_entries;
+}
+
+void AddressCache::capacity(std::size_t capacity)
+{
+    this->max_entries = capacity;
+    while (this->entries.size() > capacity)
+    {
+        this->lookup.erase(this->entries.back().key);
+        this->entries.pop_back();
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef ADDRESS_CACHE_H
+#define ADDRESS_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <node.h>
+#include <unordered_map>
+#include "netlink/socket.h"
+
+#define DEFAULT_ADDRESS_CACHE_SIZE 1024
+
+// A bounded, least recently used cache of the host strings of source
+// addresses. Peers that repeat cost a hash lookup instead of formatting the
+// address and allocating a new V8 string every datagram.
+class AddressCache
+{
+public:
+    // The host part of an address, its port is not part of the key.
+    struct Key
+    {
+        std::uint16_t family = 0;
+        std::uint32_t scope_id = 0;
+        unsigned char bytes[16] = {};
+
+        bool operator==(const Key &other) const;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const;
+    };
+
+    static Key key_of(const struct sockaddr_storage &address);
+
+    explicit AddressCache(std::size_t capacity = DEFAULT_ADDRESS_CACHE_SIZE);
+
+    // Gets the host string of address, formatting and caching it on a miss.
+    v8::Local<v8::String> host(const struct sockaddr_storage &address);
+
+    std::size_t capacity() const;
+    // Sets how many hosts are kept, 0 disables caching and empties it.
+    void capacity(std::size_t capacity);
+
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+
+private:
+    struct Entry
+    {
+        Key key;
+        v8::Global<v8::String> host;
+    };
+
+    std::size_t max_entries;
+    // most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+};
+
+#endif
@@ -0,0 +1,427 @@
+#define NOMINMAX
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <nan.h>
+#include <node_buffer.h>
+#include "arg_parser.h"
+#include "buffer_pool.h"
+#include "netlinkwrapper.h"
+
+// keeps each carved Buffer aligned for typed array views over it
+#define SLAB_ALIGNMENT 8
+
+v8::Persistent<v8::FunctionTemplate> BufferPool::class_buffer_pool;
+
+BufferPool::BufferPool(std::size_t slab_size, std::size_t high_water_mark)
+{
+    this->slab_size = slab_size;
+    this->high_water_mark = high_water_mark;
+}
+
+BufferPool::~BufferPool()
+{
+    for (auto &pair : this->slabs)
+    {
+        auto slab = pair.second;
+        if (!slab->array_buffer.IsEmpty() || slab->state == SlabState::RETIRED)
+        {
+            // JS may still reference it, so orphan it and let it be freed
+            // once it is collected.
+            slab->pool = nullptr;
+            slab->array_buffer.Reset();
+        }
+        else
+        {
+            free(slab->data);
+            delete slab;
+        }
+    }
+}
+
+void BufferPool::init(v8::Local<v8::Object> exports)
+{
+    auto isolate = v8::Isolate::GetCurrent();
+
+    auto name = v8_str("BufferPool");
+    auto buffer_pool_template = v8::FunctionTemplate::New(isolate, new_buffer_pool);
+    buffer_pool_template->SetClassName(name);
+    auto instance_template = buffer_pool_template->InstanceTemplate();
+    instance_template->SetInternalFieldCount(1);
+
+    instance_template->SetAccessor(
+        v8_str("bytesInFlight"),
+        getter_bytes_in_flight,
+        NetLinkWrapper::setter_throw_exception);
+
+    instance_template->SetAccessor(
+        v8_str("highWaterMark"),
+        getter_high_water_mark,
+        NetLinkWrapper::setter_throw_exception);
+
+    instance_template->SetAccessor(
+        v8_str("hits"),
+        getter_hits,
+        NetLinkWrapper::setter_throw_exception);
+
+    instance_template->SetAccessor(
+        v8_str("misses"),
+        getter_misses,
+        NetLinkWrapper::setter_throw_exception);
+
+    instance_template->SetAccessor(
+        v8_str("slabSize"),
+        getter_slab_size,
+        NetLinkWrapper::setter_throw_exception);
+
+    NODE_SET_PROTOTYPE_METHOD(buffer_pool_template, "release", release);
+
+    Nan::Set(exports, name, Nan::GetFunction(buffer_pool_template).ToLocalChecked());
+
+    class_buffer_pool.Reset(isolate, v8::Persistent<v8::FunctionTemplate>(isolate, buffer_pool_template));
+}
+
+BufferPool *BufferPool::from_value(const v8::Local<v8::Value> &value)
+{
+    auto isolate = v8::Isolate::GetCurrent();
+    auto function_template = BufferPool::class_buffer_pool.Get(isolate);
+    if (!function_template->HasInstance(value))
+    {
+        return nullptr;
+    }
+
+    return node::ObjectWrap::Unwrap<BufferPool>(value.As<v8::Object>());
+}
+
+/* -- Slab management -- */
+
+char *BufferPool::reserve(std::size_t size)
+{
+    if (size > this->slab_size)
+    {
+        this->misses += 1;
+        return nullptr;
+    }
+
+    if (this->current != nullptr)
+    {
+        if (this->current->size - this->current->used >= size)
+        {
+            return this->current->data + this->current->used;
+        }
+
+        this->retire(this->current);
+        this->current = nullptr;
+    }
+
+    Slab *slab = nullptr;
+    if (!this->free_slabs.empty())
+    {
+        slab = this->free_slabs.back();
+        this->free_slabs.pop_back();
+        this->idle_bytes -= slab->size;
+        this->current_is_new = false;
+    }
+    else
+    {
+        auto data = static_cast<char *>(malloc(this->slab_size));
+        if (data == nullptr)
+        {
+            this->misses += 1;
+            return nullptr;
+        }
+
+        slab = new Slab();
+        slab->pool = this;
+        slab->data = data;
+        slab->size = this->slab_size;
+        this->slabs[data] = slab;
+        this->current_is_new = true;
+    }
+
+    slab->state = SlabState::CURRENT;
+    this->current = slab;
+
+    if (!this->ensure_array_buffer(slab))
+    {
+        this->misses += 1;
+        return nullptr;
+    }
+
+    return slab->data + slab->used;
+}
+
+v8::Local<v8::Object> BufferPool::commit(std::size_t length)
+{
+    auto isolate = v8::Isolate::GetCurrent();
+    auto slab = this->current;
+
+    auto array_buffer = slab->array_buffer.Get(isolate);
+    auto view = node::Buffer::New(isolate, array_buffer, slab->used, length).ToLocalChecked();
+
+    slab->outstanding[slab->used] = length;
+    slab->outstanding_bytes += length;
+
+    // never 0, so every Buffer starts at its own offset
+    auto aligned = std::max<std::size_t>(
+        SLAB_ALIGNMENT,
+        (length + SLAB_ALIGNMENT - 1) & ~static_cast<std::size_t>(SLAB_ALIGNMENT - 1));
+    slab->used = std::min(slab->size, slab->used + aligned);
+    this->bytes_in_flight += length;
+
+    if (this->current_is_new)
+    {
+        this->misses += 1;
+        this->current_is_new = false;
+    }
+    else
+    {
+        this->hits += 1;
+    }
+
+    return view;
+}
+
+v8::Local<v8::Object> BufferPool::copy(const char *data, std::size_t length)
+{
+    auto reserved = this->reserve(length);
+    if (reserved == nullptr)
+    {
+        return Nan::CopyBuffer(data, length).ToLocalChecked();
+    }
+
+    memcpy(reserved, data, length);
+    return this->commit(length);
+}
+
+bool BufferPool::ensure_array_buffer(Slab *slab)
+{
+    if (!slab->array_buffer.IsEmpty())
+    {
+        return true;
+    }
+
+    auto maybe_buffer = Nan::NewBuffer(slab->data, slab->size, on_slab_collected, slab);
+    v8::Local<v8::Object> buffer;
+    if (!maybe_buffer.ToLocal(&buffer))
+    {
+        return false;
+    }
+
+    auto isolate = v8::Isolate::GetCurrent();
+    slab->array_buffer.Reset(isolate, buffer.As<v8::Uint8Array>()->Buffer());
+    return true;
+}
+
+void BufferPool::retire(Slab *slab)
+{
+    slab->state = SlabState::RETIRED;
+    if (slab->outstanding.empty())
+    {
+        this->recycle(slab);
+    }
+    else
+    {
+        // Becomes eligible for garbage collection once JS drops every
+        // Buffer carved from it, at which point on_slab_collected runs.
+        slab->array_buffer.SetWeak();
+    }
+}
+
+void BufferPool::recycle(Slab *slab)
+{
+    slab->used = 0;
+    slab->outstanding.clear();
+    slab->outstanding_bytes = 0;
+
+    if (this->idle_bytes + slab->size > this->high_water_mark)
+    {
+        this->drop(slab);
+        return;
+    }
+
+    if (!slab->array_buffer.IsEmpty())
+    {
+        slab->array_buffer.ClearWeak();
+    }
+
+    slab->state = SlabState::FREE;
+    this->idle_bytes += slab->size;
+    this->free_slabs.push_back(slab);
+}
+
+void BufferPool::drop(Slab *slab)
+{
+    if (!slab->array_buffer.IsEmpty())
+    {
+        // JS owns the memory now, it is freed once collected
+        slab->pool = nullptr;
+        slab->array_buffer.Reset();
+        this->slabs.erase(slab->data);
+        return;
+    }
+
+    this->slabs.erase(slab->data);
+    free(slab->data);
+    delete slab;
+}
+
+void BufferPool::on_slab_collected(char *data, void *hint)
+{
+    auto slab = static_cast<Slab *>(hint);
+    auto pool = slab->pool;
+    slab->array_buffer.Reset();
+
+    if (pool == nullptr)
+    {
+        free(data);
+        delete slab;
+        return;
+    }
+
+    // anything not explicitly released is now implicitly released
+    pool->bytes_in_flight -= slab->outstanding_bytes;
+    pool->recycle(slab);
+}
+
+/* -- JS Constructors -- */
+
+void BufferPool::new_buffer_pool(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    if (!args.IsConstructCall())
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("BufferPool constructor must be invoked via 'new'.")));
+        return;
+    }
+
+    std::uint32_t slab_size = DEFAULT_SLAB_SIZE;
+    std::uint32_t high_water_mark = DEFAULT_HIGH_WATER_MARK;
+
+    if (ArgParser(args)
+            .opt("slabSize", slab_size)
+            .opt("highWaterMark", high_water_mark)
+            .isInvalid())
+    {
+        return;
+    }
+
+    if (slab_size == 0)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::RangeError(v8_str("Argument \"slabSize\" must be greater than 0.")));
+        return;
+    }
+
+    BufferPool *obj = new BufferPool(slab_size, high_water_mark);
+    obj->Wrap(args.This());
+    args.GetReturnValue().Set(args.This());
+}
+
+/* -- JS methods -- */
+
+void BufferPool::release(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    GetValue::BufferView view;
+    if (ArgParser(args)
+            .arg("buffer", view)
+            .isInvalid())
+    {
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<BufferPool>(args.Holder());
+
+    // find the slab whose memory range contains this Buffer
+    auto found = obj->slabs.upper_bound(view.data);
+    Slab *slab = nullptr;
+    if (found != obj->slabs.begin())
+    {
+        --found;
+        if (view.data < found->first + found->second->size)
+        {
+            slab = found->second;
+        }
+    }
+
+    if (slab == nullptr || slab->state == SlabState::FREE)
+    {
+        // not pooled (e.g. too large for a slab)
+        args.GetReturnValue().Set(Nan::New(false));
+        return;
+    }
+
+    // only exactly a Buffer this pool handed out, and still outstanding, may
+    // be released. Anything else (a slice of one, or one already released)
+    // would free memory JS still holds.
+    auto handed_out = slab->outstanding.find(static_cast<std::size_t>(view.data - slab->data));
+    if (handed_out == slab->outstanding.end() || handed_out->second != view.length)
+    {
+        args.GetReturnValue().Set(Nan::New(false));
+        return;
+    }
+
+    auto length = handed_out->second;
+    slab->outstanding.erase(handed_out);
+    slab->outstanding_bytes -= length;
+    obj->bytes_in_flight -= length;
+
+    if (slab->outstanding.empty())
+    {
+        if (slab->state == SlabState::CURRENT)
+        {
+            // nothing carved from it is in use, so start over from the top
+            slab->used = 0;
+            slab->outstanding_bytes = 0;
+        }
+        else if (!slab->array_buffer.IsEmpty())
+        {
+            obj->recycle(slab);
+        }
+        // else it was already collected, and on_slab_collected recycles it
+    }
+
+    args.GetReturnValue().Set(Nan::New(true));
+}
+
+/* -- Getters -- */
+
+void BufferPool::getter_bytes_in_flight(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<BufferPool>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(obj->bytes_in_flight)));
+}
+
+void BufferPool::getter_high_water_mark(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<BufferPool>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(obj->high_water_mark)));
+}
+
+void BufferPool::getter_hits(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<BufferPool>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(obj->hits)));
+}
+
+void BufferPool::getter_misses(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<BufferPool>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(obj->misses)));
+}
+
+void BufferPool::getter_slab_size(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<BufferPool>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(obj->slab_size)));
+}
@@ -0,0 +1,113 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <node.h>
+#include <node_object_wrap.h>
+#include <unordered_map>
+#include <vector>
+
+#define DEFAULT_SLAB_SIZE (64 * 1024)
+#define DEFAULT_HIGH_WATER_MARK (16 * DEFAULT_SLAB_SIZE)
+
+// An opt-in pool that received Buffers are carved out of.
+// Memory is allocated in large slabs, each exposed to JS as a single external
+// ArrayBuffer, and every received message is a Buffer view into a slab. Slabs
+// are recycled once all of their messages are released, either explicitly via
+// release() or automatically once the slab's ArrayBuffer is garbage collected.
+class BufferPool : public node::ObjectWrap
+{
+public:
+    static void init(v8::Local<v8::Object> exports);
+
+    // Gets the BufferPool wrapped by a JS value, or nullptr if it is not one.
+    static BufferPool *from_value(const v8::Local<v8::Value> &value);
+
+    // Reserves `size` writable bytes from the current slab. The memory is
+    // only handed to JS once commit() is called. Returns nullptr when `size`
+    // is too large to ever fit in a slab, the caller should not pool it then.
+    char *reserve(std::size_t size);
+
+    // Hands the first `length` bytes of the last reserve() to JS as a Buffer.
+    v8::Local<v8::Object> commit(std::size_t length);
+
+    // Copies `data` into pooled memory when it fits, otherwise into a fresh
+    // (non pooled) Buffer.
+    v8::Local<v8::Object> copy(const char *data, std::size_t length);
+
+private:
+    enum class SlabState
+    {
+        CURRENT,
+        FREE,
+        RETIRED,
+    };
+
+    struct Slab
+    {
+        BufferPool *pool;
+        char *data;
+        std::size_t size;
+        std::size_t used = 0;
+        // offset -> length of every Buffer carved from it and not yet
+        // released, so only those exact Buffers can be released, once
+        std::unordered_map<std::size_t, std::size_t> outstanding;
+        std::size_t outstanding_bytes = 0;
+        SlabState state = SlabState::FREE;
+        // strong while CURRENT or FREE, weak once RETIRED so it can be
+        // collected when JS is done with every message carved from it
+        v8::Global<v8::ArrayBuffer> array_buffer;
+    };
+
+    std::size_t slab_size;
+    std::size_t high_water_mark;
+
+    Slab *current = nullptr;
+    bool current_is_new = false;
+    std::vector<Slab *> free_slabs;
+    std::map<char *, Slab *> slabs;
+
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::size_t bytes_in_flight = 0;
+    std::size_t idle_bytes = 0;
+
+    BufferPool(std::size_t slab_size, std::size_t high_water_mark);
+    ~BufferPool();
+
+    bool ensure_array_buffer(Slab *slab);
+    void retire(Slab *slab);
+    void recycle(Slab *slab);
+    void drop(Slab *slab);
+
+    static void on_slab_collected(char *data, void *hint);
+
+    static v8::Persistent<v8::FunctionTemplate> class_buffer_pool;
+
+    /* -- Class Constructors -- */
+    static void new_buffer_pool(const v8::FunctionCallbackInfo<v8::Value> &args);
+
+    /* -- Methods -- */
+    static void release(const v8::FunctionCallbackInfo<v8::Value> &args);
+
+    /* -- Getters -- */
+    static void getter_bytes_in_flight(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_high_water_mark(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_hits(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_misses(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_slab_size(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+};
+
+#endif
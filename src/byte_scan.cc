@@ -0,0 +1,248 @@
+#include <cstring>
+#include "byte_scan.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BYTE_SCAN_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(BYTE_SCAN_SSE2) && (defined(__GNUC__) || defined(__clang__))
+// AVX2 is compiled via a target attribute and only used when the CPU running
+// us supports it, so the rest of the addon does not need -mavx2.
+#define BYTE_SCAN_AVX2
+#include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+static inline unsigned first_set_bit(unsigned mask)
+{
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+}
+#else
+static inline unsigned first_set_bit(unsigned mask)
+{
+    return __builtin_ctz(mask);
+}
+#endif
+
+#ifdef BYTE_SCAN_SSE2
+static const char *find_byte_sse2(const char *data, std::size_t length, char byte)
+{
+    auto needle = _mm_set1_epi8(byte);
+    std::size_t i = 0;
+
+    if (length < 16)
+    {
+        for (; i < length; i++)
+        {
+            if (data[i] == byte)
+            {
+                return data + i;
+            }
+        }
+        return nullptr;
+    }
+
+    for (; i + 16 <= length; i += 16)
+    {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        if (mask != 0)
+        {
+            return data + i + first_set_bit(mask);
+        }
+    }
+
+    if (i < length)
+    {
+        // overlap the last full 16 bytes, ignoring what was already checked
+        auto last = length - 16;
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + last));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        mask >>= (i - last);
+        if (mask != 0)
+        {
+            return data + i + first_set_bit(mask);
+        }
+    }
+
+    return nullptr;
+}
+#endif
+
+#ifdef BYTE_SCAN_SSE2
+static std::size_t ascii_length_sse2(const char *data, std::size_t length)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        // the high bit of every byte, which is only set outside of ASCII
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(chunk));
+        if (mask != 0)
+        {
+            return i + first_set_bit(mask);
+        }
+    }
+
+    for (; i < length; i++)
+    {
+        if (static_cast<unsigned char>(data[i]) >= 0x80)
+        {
+            return i;
+        }
+    }
+
+    return length;
+}
+#endif
+
+#ifdef BYTE_SCAN_AVX2
+__attribute__((target("avx2"))) static const char *find_byte_avx2(const char *data, std::size_t length, char byte)
+{
+    if (length < 32)
+    {
+        return find_byte_sse2(data, length, byte);
+    }
+
+    auto needle = _mm256_set1_epi8(byte);
+    std::size_t i = 0;
+
+    // two vectors per iteration, only working out where once either hits
+    for (; i + 64 <= length; i += 64)
+    {
+        auto low = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), needle);
+        auto high = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 32)), needle);
+        if (!_mm256_testz_si256(_mm256_or_si256(low, high), _mm256_or_si256(low, high)))
+        {
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(low));
+            if (mask != 0)
+            {
+                return data + i + first_set_bit(mask);
+            }
+            mask = static_cast<unsigned>(_mm256_movemask_epi8(high));
+            return data + i + 32 + first_set_bit(mask);
+        }
+    }
+
+    for (; i + 32 <= length; i += 32)
+    {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+        if (mask != 0)
+        {
+            return data + i + first_set_bit(mask);
+        }
+    }
+
+    if (i < length)
+    {
+        // overlap the last full 32 bytes, ignoring what was already checked
+        auto last = length - 32;
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + last));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+        mask >>= (i - last);
+        if (mask != 0)
+        {
+            return data + i + first_set_bit(mask);
+        }
+    }
+
+    return nullptr;
+}
+
+__attribute__((target("avx2"))) static std::size_t ascii_length_avx2(const char *data, std::size_t length)
+{
+    std::size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(chunk));
+        if (mask != 0)
+        {
+            return i + first_set_bit(mask);
+        }
+    }
+
+    return i + ascii_length_sse2(data + i, length - i);
+}
+
+static bool has_avx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+const char *ByteScan::find_byte(const char *data, std::size_t length, char byte)
+{
+#if defined(BYTE_SCAN_AVX2)
+    if (has_avx2())
+    {
+        return find_byte_avx2(data, length, byte);
+    }
+    return find_byte_sse2(data, length, byte);
+#elif defined(BYTE_SCAN_SSE2)
+    return find_byte_sse2(data, length, byte);
+#else
+    return static_cast<const char *>(memchr(data, byte, length));
+#endif
+}
+
+std::size_t ByteScan::ascii_length(const char *data, std::size_t length)
+{
+#if defined(BYTE_SCAN_AVX2)
+    if (has_avx2())
+    {
+        return ascii_length_avx2(data, length);
+    }
+    return ascii_length_sse2(data, length);
+#elif defined(BYTE_SCAN_SSE2)
+    return ascii_length_sse2(data, length);
+#else
+    for (std::size_t i = 0; i < length; i++)
+    {
+        if (static_cast<unsigned char>(data[i]) >= 0x80)
+        {
+            return i;
+        }
+    }
+    return length;
+#endif
+}
+
+const char *ByteScan::find_delimiter(
+    const char *data,
+    std::size_t length,
+    const char *delimiter,
+    std::size_t delimiter_length)
+{
+    if (delimiter_length == 0 || delimiter_length > length)
+    {
+        return nullptr;
+    }
+
+    // scan for the first byte, then confirm the rest of the delimiter
+    auto end = data + length - delimiter_length + 1;
+    auto position = data;
+    while (position < end)
+    {
+        auto found = find_byte(position, end - position, delimiter[0]);
+        if (found == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (memcmp(found + 1, delimiter + 1, delimiter_length - 1) == 0)
+        {
+            return found;
+        }
+
+        position = found + 1;
+    }
+
+    return nullptr;
+}
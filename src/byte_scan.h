@@ -0,0 +1,25 @@
+#ifndef BYTE_SCAN_H
+#define BYTE_SCAN_H
+
+#include <cstddef>
+
+namespace ByteScan
+{
+    // Finds the first occurrence of byte in data, or nullptr if there is none.
+    // Uses AVX2 or SSE2 when the CPU supports them, otherwise memchr.
+    const char *find_byte(const char *data, std::size_t length, char byte);
+
+    // Gets the length of the leading run of ASCII (< 0x80) bytes in data.
+    // Uses AVX2 or SSE2 when the CPU supports them.
+    std::size_t ascii_length(const char *data, std::size_t length);
+
+    // Finds the first occurrence of a (possibly multi-byte) delimiter in data,
+    // or nullptr if there is none.
+    const char *find_delimiter(
+        const char *data,
+        std::size_t length,
+        const char *delimiter,
+        std::size_t delimiter_length);
+} // namespace ByteScan
+
+#endif
@@ -0,0 +1,74 @@
+#include <sstream>
+#include "connect_worker.h"
+#include "netlinkwrapper.h"
+
+ConnectWorker::ConnectWorker(
+    v8::Local<v8::Promise::Resolver> resolver,
+    const std::string &host,
+    std::uint16_t port,
+    NL::IPVer ip_version,
+    std::uint32_t connect_timeout,
+    std::uint32_t connect_stagger)
+    : Nan::AsyncWorker(nullptr, "NetLinkSocket:connect")
+{
+    auto isolate = v8::Isolate::GetCurrent();
+
+    this->host = host;
+    this->port = port;
+    this->ip_version = ip_version;
+    this->connect_timeout = connect_timeout;
+    this->connect_stagger = connect_stagger;
+    this->resolver.Reset(isolate, resolver);
+    this->context = node::EmitAsyncInit(isolate, resolver->GetPromise(), "NetLinkSocket:connect");
+}
+
+ConnectWorker::~ConnectWorker()
+{
+    // only left over if the promise was never settled
+    delete this->socket;
+
+    node::EmitAsyncDestroy(v8::Isolate::GetCurrent(), this->context);
+}
+
+void ConnectWorker::Execute()
+{
+    try
+    {
+        this->socket = new NL::Socket(
+            this->host,
+            this->port,
+            NL::Protocol::TCP,
+            this->ip_version,
+            this->connect_timeout,
+            this->connect_stagger);
+    }
+    catch (NL::Exception &err)
+    {
+        std::stringstream ss;
+        ss << "[NetLinkSocket Error " << err.code() << "]: " << err.msg();
+        this->SetErrorMessage(ss.str().c_str());
+    }
+}
+
+void ConnectWorker::HandleOKCallback()
+{
+    auto isolate = v8::Isolate::GetCurrent();
+    auto resolver = this->resolver.Get(isolate);
+    // drains the microtask queue on the way out, so awaiting code runs now
+    node::CallbackScope scope(isolate, resolver->GetPromise(), this->context);
+
+    auto instance = NetLinkWrapper::wrap_tcp_client(this->socket);
+    this->socket = nullptr;
+
+    resolver->Resolve(isolate->GetCurrentContext(), instance).Check();
+}
+
+void ConnectWorker::HandleErrorCallback()
+{
+    auto isolate = v8::Isolate::GetCurrent();
+    auto resolver = this->resolver.Get(isolate);
+    node::CallbackScope scope(isolate, resolver->GetPromise(), this->context);
+
+    auto error = v8::Exception::Error(v8_str(this->ErrorMessage()));
+    resolver->Reject(isolate->GetCurrentContext(), error).Check();
+}
@@ -0,0 +1,50 @@
+#ifndef CONNECT_WORKER_H
+#define CONNECT_WORKER_H
+
+#include <cstdint>
+#include <nan.h>
+#include <node.h>
+#include <string>
+#include "netlink/socket.h"
+
+// milliseconds SocketClientTCP.connect() waits at most by default, as each
+// pending connect holds one of the few libuv thread pool workers
+#define DEFAULT_ASYNC_CONNECT_TIMEOUT (30 * 1000)
+
+// Resolves and connects a TCP client on the libuv thread pool, so neither the
+// host lookup nor the handshake blocks the event loop. Settles the promise
+// with the connected SocketClientTCP, or rejects it with the NetLinkSocket
+// error that stopped it.
+class ConnectWorker : public Nan::AsyncWorker
+{
+public:
+    ConnectWorker(
+        v8::Local<v8::Promise::Resolver> resolver,
+        const std::string &host,
+        std::uint16_t port,
+        NL::IPVer ip_version,
+        std::uint32_t connect_timeout,
+        std::uint32_t connect_stagger);
+    ~ConnectWorker();
+
+    void Execute() override;
+
+protected:
+    void HandleOKCallback() override;
+    void HandleErrorCallback() override;
+
+private:
+    std::string host;
+    std::uint16_t port;
+    NL::IPVer ip_version;
+    std::uint32_t connect_timeout;
+    std::uint32_t connect_stagger;
+
+    // owned until handed to the SocketClientTCP it is wrapped in
+    NL::Socket *socket = nullptr;
+
+    v8::Global<v8::Promise::Resolver> resolver;
+    node::async_context context;
+};
+
+#endif
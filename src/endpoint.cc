@@ -0,0 +1,136 @@
+#include <cstdint>
+#include <nan.h>
+#include "arg_parser.h"
+#include "endpoint.h"
+#include "netlinkwrapper.h"
+#include "netlink/exception.h"
+#include "netlink/resolver.h"
+
+v8::Persistent<v8::FunctionTemplate> Endpoint::class_endpoint;
+
+Endpoint::Endpoint(const struct sockaddr_storage &address, NL::IPVer ip_version)
+{
+    this->address = address;
+    this->ip_version = ip_version;
+}
+
+void Endpoint::init(v8::Local<v8::Object> exports)
+{
+    auto isolate = v8::Isolate::GetCurrent();
+
+    auto name = v8_str("Endpoint");
+    auto endpoint_template = v8::FunctionTemplate::New(isolate, new_endpoint);
+    endpoint_template->SetClassName(name);
+    auto instance_template = endpoint_template->InstanceTemplate();
+    instance_template->SetInternalFieldCount(1);
+
+    instance_template->SetAccessor(
+        v8_str("host"),
+        getter_host,
+        NetLinkWrapper::setter_throw_exception);
+
+    instance_template->SetAccessor(
+        v8_str("isIPv4"),
+        getter_is_ipv4,
+        NetLinkWrapper::setter_throw_exception);
+
+    instance_template->SetAccessor(
+        v8_str("isIPv6"),
+        getter_is_ipv6,
+        NetLinkWrapper::setter_throw_exception);
+
+    instance_template->SetAccessor(
+        v8_str("port"),
+        getter_port,
+        NetLinkWrapper::setter_throw_exception);
+
+    Nan::Set(exports, name, Nan::GetFunction(endpoint_template).ToLocalChecked());
+
+    class_endpoint.Reset(isolate, v8::Persistent<v8::FunctionTemplate>(isolate, endpoint_template));
+}
+
+Endpoint *Endpoint::from_value(const v8::Local<v8::Value> &value)
+{
+    auto isolate = v8::Isolate::GetCurrent();
+    auto function_template = Endpoint::class_endpoint.Get(isolate);
+    if (!function_template->HasInstance(value))
+    {
+        return nullptr;
+    }
+
+    return node::ObjectWrap::Unwrap<Endpoint>(value.As<v8::Object>());
+}
+
+/* -- JS Constructors -- */
+
+void Endpoint::new_endpoint(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    if (!args.IsConstructCall())
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Endpoint constructor must be invoked via 'new'.")));
+        return;
+    }
+
+    std::string host;
+    std::uint16_t port = 0;
+    NL::IPVer ip_version = NL::IPVer::IP4;
+
+    if (ArgParser(args)
+            .arg("host", host)
+            .arg("port", port)
+            .opt("ipVersion", ip_version)
+            .isInvalid())
+    {
+        return;
+    }
+
+    struct sockaddr_storage address;
+    try
+    {
+        NL::Resolver::resolve(host, port, ip_version, address);
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    Endpoint *obj = new Endpoint(address, ip_version);
+    obj->Wrap(args.This());
+    args.GetReturnValue().Set(args.This());
+}
+
+/* -- Getters -- */
+
+void Endpoint::getter_host(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<Endpoint>(info.Holder());
+    info.GetReturnValue().Set(v8_str(NL::Socket::hostFromAddress(obj->address)));
+}
+
+void Endpoint::getter_is_ipv4(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<Endpoint>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(obj->ip_version == NL::IPVer::IP4));
+}
+
+void Endpoint::getter_is_ipv6(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<Endpoint>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(obj->ip_version == NL::IPVer::IP6));
+}
+
+void Endpoint::getter_port(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<Endpoint>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(NL::Socket::portFromAddress(obj->address)));
+}
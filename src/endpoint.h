@@ -0,0 +1,44 @@
+#ifndef ENDPOINT_H
+#define ENDPOINT_H
+
+#include <node.h>
+#include <node_object_wrap.h>
+#include "netlink/socket.h"
+
+// A host and port resolved once, up front, into a native address. Sends given
+// one skip parsing the host and port, and looking them up, every call.
+class Endpoint : public node::ObjectWrap
+{
+public:
+    static void init(v8::Local<v8::Object> exports);
+
+    // Gets the Endpoint wrapped by a JS value, or nullptr if it is not one.
+    static Endpoint *from_value(const v8::Local<v8::Value> &value);
+
+    struct sockaddr_storage address;
+    NL::IPVer ip_version;
+
+private:
+    Endpoint(const struct sockaddr_storage &address, NL::IPVer ip_version);
+
+    static v8::Persistent<v8::FunctionTemplate> class_endpoint;
+
+    /* -- Class Constructors -- */
+    static void new_endpoint(const v8::FunctionCallbackInfo<v8::Value> &args);
+
+    /* -- Getters -- */
+    static void getter_host(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_is_ipv4(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_is_ipv6(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_port(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+};
+
+#endif
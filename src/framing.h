@@ -0,0 +1,106 @@
+#ifndef FRAMING_H
+#define FRAMING_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define DEFAULT_MAX_FRAME_LENGTH (16 * 1024 * 1024)
+
+namespace Framing
+{
+    // How the length of each message is prefixed on the stream.
+    enum Prefix
+    {
+        None,
+        UInt8,
+        UInt16BE,
+        UInt16LE,
+        UInt32BE,
+        UInt32LE,
+        VarInt, // unsigned LEB128, as used by protobuf
+    };
+
+    enum HeaderStatus
+    {
+        Complete,
+        Incomplete,
+        Malformed,
+    };
+
+    // Decodes the length prefix at the start of data.
+    // On Complete, header_length is the size of the prefix itself and
+    // frame_length the size of the payload following it.
+    inline HeaderStatus read_header(
+        Prefix prefix,
+        const unsigned char *data,
+        std::size_t available,
+        std::size_t &header_length,
+        std::uint64_t &frame_length)
+    {
+        switch (prefix)
+        {
+        case UInt8:
+            header_length = 1;
+            break;
+        case UInt16BE:
+        case UInt16LE:
+            header_length = 2;
+            break;
+        case UInt32BE:
+        case UInt32LE:
+            header_length = 4;
+            break;
+        case VarInt:
+        {
+            frame_length = 0;
+            for (std::size_t i = 0; i < 10; i++)
+            {
+                if (i >= available)
+                {
+                    return Incomplete;
+                }
+
+                frame_length |= static_cast<std::uint64_t>(data[i] & 0x7F) << (7 * i);
+                if ((data[i] & 0x80) == 0)
+                {
+                    header_length = i + 1;
+                    return Complete;
+                }
+            }
+            return Malformed; // longer than any 64 bit varint
+        }
+        default:
+            return Malformed;
+        }
+
+        if (available < header_length)
+        {
+            return Incomplete;
+        }
+
+        switch (prefix)
+        {
+        case UInt8:
+            frame_length = data[0];
+            break;
+        case UInt16BE:
+            frame_length = (data[0] << 8) | data[1];
+            break;
+        case UInt16LE:
+            frame_length = data[0] | (data[1] << 8);
+            break;
+        case UInt32BE:
+            frame_length = (static_cast<std::uint64_t>(data[0]) << 24) |
+                           (data[1] << 16) | (data[2] << 8) | data[3];
+            break;
+        default: // UInt32LE
+            frame_length = data[0] | (data[1] << 8) | (data[2] << 16) |
+                           (static_cast<std::uint64_t>(data[3]) << 24);
+            break;
+        }
+
+        return Complete;
+    }
+} // namespace Framing
+
+#endif
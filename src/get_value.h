@@ -5,7 +5,18 @@
 #include <nan.h>
 #include <node.h>
 #include <sstream>
+#include <vector>
+#include "endpoint.h"
+#include "framing.h"
 #include "netlinkwrapper.h"
+#include "string_decode.h"
+
+// longest string encoded into the send scratch
+#define MAX_SCRATCH_STRING_LENGTH (256 * 1024)
+// most the send scratch holds across every string of one send, each UTF-16
+// code unit taking up to 3 bytes as UTF-8. Strings beyond it are encoded
+// into their own memory instead.
+#define MAX_SEND_SCRATCH_SIZE (3 * MAX_SCRATCH_STRING_LENGTH * 4)
 
 namespace GetValue
 {
@@ -13,9 +24,102 @@ namespace GetValue
     {
         None,
         SendableData,
+        // an NL::IPVer that may also be ANY, for sockets that pick a family
+        AnyIPVersion,
+    };
+
+    // A view of memory owned by a Buffer or Uint8Array. It does not copy, so
+    // it is only valid for the duration of the synchronous call it was
+    // parsed during.
+    struct BufferView
+    {
+        char *data = nullptr;
+        std::size_t length = 0;
+    };
+
+    // Memory JS strings to send are encoded into. Shared by every send on
+    // this thread, so once it has grown to fit they encode without allocating.
+    // Only valid for the duration of the synchronous call it was filled
+    // during, which empties it via reset_send_scratch() first.
+    inline std::vector<char> &send_scratch()
+    {
+        static thread_local std::vector<char> scratch;
+        return scratch;
+    }
+
+    inline void reset_send_scratch()
+    {
+        auto &scratch = send_scratch();
+        scratch.clear();
+        if (scratch.capacity() > MAX_SEND_SCRATCH_SIZE)
+        {
+            // vector growth can overshoot the cap, so give the rest back
+            std::vector<char> bounded;
+            bounded.reserve(MAX_SEND_SCRATCH_SIZE);
+            scratch.swap(bounded);
+        }
+    }
+
+    // Data to send. Buffers and Uint8Arrays are borrowed like a BufferView,
+    // so they are handed to the kernel without a copy. Only JS strings are
+    // encoded (as UTF-8) into memory of our own: the send scratch, or their
+    // own string if too long to keep around in it.
+    struct SendableView
+    {
+        BufferView view;
+        std::string encoded;
+        std::size_t scratch_offset = 0;
+        bool is_string = false;
+        bool in_scratch = false;
+
+        const char *data() const
+        {
+            if (this->in_scratch)
+            {
+                return send_scratch().data() + this->scratch_offset;
+            }
+            return this->is_string ? this->encoded.data() : this->view.data;
+        }
+
+        std::size_t length() const
+        {
+            return this->is_string && !this->in_scratch ? this->encoded.length() : this->view.length;
+        }
+
+        // Moves a string out of the send scratch into memory of its own, for
+        // when the kernel may still read from it after the call returns.
+        void own()
+        {
+            if (this->in_scratch)
+            {
+                this->encoded.assign(this->data(), this->length());
+                this->in_scratch = false;
+            }
+        }
     };
 
-    std::string get_typeof_str(const v8::Local<v8::Value> &arg)
+    // Options of a single send.
+    struct SendOptions
+    {
+        // more data follows soon, so hold this back to fill a segment
+        bool more = false;
+    };
+
+    // A host and port to connect to.
+    struct HostPort
+    {
+        std::string host;
+        std::uint16_t port = 0;
+    };
+
+    // A file to send, either by path or by an open file descriptor.
+    struct FileSource
+    {
+        std::string path;
+        int fd = -1;
+    };
+
+    inline std::string get_typeof_str(const v8::Local<v8::Value> &arg)
     {
         auto isolate = v8::Isolate::GetCurrent();
         auto type_of = arg->TypeOf(isolate);
@@ -36,7 +140,7 @@ namespace GetValue
     }
 
     template <>
-    std::string get_value(
+    inline std::string get_value(
         std::uint16_t &value,
         const v8::Local<v8::Value> &arg,
         SubType sub_type)
@@ -69,7 +173,65 @@ namespace GetValue
     }
 
     template <>
-    std::string get_value(
+    inline std::string get_value(
+        std::uint32_t &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        if (!arg->IsNumber())
+        {
+            return "must be a number. " + get_typeof_str(arg);
+        }
+
+        auto isolate = v8::Isolate::GetCurrent();
+        auto as_number = arg->IntegerValue(isolate->GetCurrentContext()).FromJust();
+
+        if (as_number < 0)
+        {
+            std::stringstream ss;
+            ss << as_number << " must not be negative.";
+            return ss.str();
+        }
+
+        if (as_number > UINT32_MAX)
+        {
+            std::stringstream ss;
+            ss << as_number << " beyond max range of "
+               << UINT32_MAX << ".";
+            return ss.str();
+        }
+
+        value = static_cast<std::uint32_t>(as_number);
+        return "";
+    }
+
+    template <>
+    inline std::string get_value(
+        std::uint64_t &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        if (!arg->IsNumber())
+        {
+            return "must be a number. " + get_typeof_str(arg);
+        }
+
+        auto isolate = v8::Isolate::GetCurrent();
+        auto as_number = arg->IntegerValue(isolate->GetCurrentContext()).FromJust();
+
+        if (as_number < 0)
+        {
+            std::stringstream ss;
+            ss << as_number << " must not be negative.";
+            return ss.str();
+        }
+
+        value = static_cast<std::uint64_t>(as_number);
+        return "";
+    }
+
+    template <>
+    inline std::string get_value(
         bool &value,
         const v8::Local<v8::Value> &arg,
         SubType sub_type)
@@ -85,12 +247,31 @@ namespace GetValue
     }
 
     template <>
-    std::string get_value(
+    inline std::string get_value(
+        Endpoint *&value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        value = Endpoint::from_value(arg);
+        if (value == nullptr)
+        {
+            std::stringstream ss;
+            ss << "must be an Endpoint. " << get_typeof_str(arg);
+            return ss.str();
+        }
+
+        return "";
+    }
+
+    template <>
+    inline std::string get_value(
         NL::IPVer &value,
         const v8::Local<v8::Value> &arg,
         SubType sub_type)
     {
-        std::string invalid_string("must be an ip version string either 'IPv4' or 'IPv6'.");
+        std::string invalid_string(sub_type == SubType::AnyIPVersion
+                                       ? "must be an ip version string either 'IPv4', 'IPv6', or 'any'."
+                                       : "must be an ip version string either 'IPv4' or 'IPv6'.");
         if (!arg->IsString())
         {
             std::stringstream ss;
@@ -109,6 +290,10 @@ namespace GetValue
         {
             value = NL::IPVer::IP4;
         }
+        else if (str.compare("any") == 0 && sub_type == SubType::AnyIPVersion)
+        {
+            value = NL::IPVer::ANY;
+        }
         else
         {
             std::stringstream ss;
@@ -120,7 +305,101 @@ namespace GetValue
     }
 
     template <>
-    std::string get_value(
+    inline std::string get_value(
+        Framing::Prefix &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        std::string invalid_string("must be a framing prefix string of 'none', 'uint8', 'uint16be', 'uint16le', 'uint32be', 'uint32le', or 'varint'.");
+        if (!arg->IsString())
+        {
+            std::stringstream ss;
+            ss << invalid_string << " " << get_typeof_str(arg);
+            return ss.str();
+        }
+
+        Nan::Utf8String utf8_string(arg);
+        std::string str(*utf8_string);
+
+        if (str.compare("none") == 0)
+        {
+            value = Framing::Prefix::None;
+        }
+        else if (str.compare("uint8") == 0)
+        {
+            value = Framing::Prefix::UInt8;
+        }
+        else if (str.compare("uint16be") == 0)
+        {
+            value = Framing::Prefix::UInt16BE;
+        }
+        else if (str.compare("uint16le") == 0)
+        {
+            value = Framing::Prefix::UInt16LE;
+        }
+        else if (str.compare("uint32be") == 0)
+        {
+            value = Framing::Prefix::UInt32BE;
+        }
+        else if (str.compare("uint32le") == 0)
+        {
+            value = Framing::Prefix::UInt32LE;
+        }
+        else if (str.compare("varint") == 0)
+        {
+            value = Framing::Prefix::VarInt;
+        }
+        else
+        {
+            std::stringstream ss;
+            ss << invalid_string << " Got: '" << str << "'.";
+            return ss.str();
+        }
+
+        return "";
+    }
+
+    template <>
+    inline std::string get_value(
+        StringDecode::Encoding &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        std::string invalid_string("must be an encoding string of 'utf8', 'latin1', or 'ascii'.");
+        if (!arg->IsString())
+        {
+            std::stringstream ss;
+            ss << invalid_string << " " << get_typeof_str(arg);
+            return ss.str();
+        }
+
+        Nan::Utf8String utf8_string(arg);
+        std::string str(*utf8_string);
+
+        if (str.compare("utf8") == 0 || str.compare("utf-8") == 0)
+        {
+            value = StringDecode::Encoding::Utf8;
+        }
+        else if (str.compare("latin1") == 0 || str.compare("binary") == 0)
+        {
+            value = StringDecode::Encoding::Latin1;
+        }
+        else if (str.compare("ascii") == 0)
+        {
+            value = StringDecode::Encoding::Ascii;
+        }
+        else
+        {
+            std::stringstream ss;
+            ss << invalid_string << " Got: '" << str << "'.";
+            return ss.str();
+        }
+
+        return "";
+    }
+
+    template <>
+    inline std::string get_value(
         std::string &value,
         const v8::Local<v8::Value> &arg,
         SubType sub_type)
@@ -134,7 +413,7 @@ namespace GetValue
         if (is_string)
         {
             Nan::Utf8String utf8_str(arg);
-            value = std::string(*utf8_str);
+            value.assign(*utf8_str, utf8_str.length());
         }
         else if (arg->IsUint8Array())
         {
@@ -155,6 +434,201 @@ namespace GetValue
 
         return "";
     }
+
+    template <>
+    inline std::string get_value(
+        v8::Local<v8::Array> &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        if (!arg->IsArray())
+        {
+            return "must be an array. " + get_typeof_str(arg);
+        }
+
+        value = arg.As<v8::Array>();
+        return "";
+    }
+
+    template <>
+    inline std::string get_value(
+        v8::Local<v8::Uint32Array> &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        if (!arg->IsUint32Array())
+        {
+            return "must be a Uint32Array. " + get_typeof_str(arg);
+        }
+
+        value = arg.As<v8::Uint32Array>();
+        return "";
+    }
+
+    template <>
+    inline std::string get_value(
+        BufferView &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        if (arg->IsUint8Array())
+        {
+            auto typed_array = arg.As<v8::TypedArray>();
+            Nan::TypedArrayContents<char> contents(typed_array);
+            value.data = *contents;
+            value.length = contents.length();
+        }
+        else if (node::Buffer::HasInstance(arg))
+        {
+            value.data = node::Buffer::Data(arg);
+            value.length = node::Buffer::Length(arg);
+        }
+        else
+        {
+            return "must be a Buffer or Uint8Array. " + get_typeof_str(arg);
+        }
+
+        return "";
+    }
+
+    template <>
+    inline std::string get_value(
+        SendableView &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        if (arg->IsString())
+        {
+            value.is_string = true;
+            auto str = arg.As<v8::String>();
+            auto &scratch = send_scratch();
+            auto length = static_cast<std::size_t>(str->Length());
+            if (length > MAX_SCRATCH_STRING_LENGTH || scratch.size() + 3 * length > MAX_SEND_SCRATCH_SIZE)
+            {
+                value.in_scratch = false;
+                return get_value(value.encoded, arg, sub_type);
+            }
+
+            value.in_scratch = true;
+            value.scratch_offset = scratch.size();
+            value.view.length = StringDecode::encode_utf8(str, scratch);
+            return "";
+        }
+
+        value.is_string = false;
+        value.in_scratch = false;
+        auto error = get_value(value.view, arg, sub_type);
+        if (error.length() > 0)
+        {
+            return "must be a string, Buffer, or Uint8Array";
+        }
+
+        return "";
+    }
+
+    template <>
+    inline std::string get_value(
+        FileSource &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        if (arg->IsString())
+        {
+            value.fd = -1;
+            return get_value(value.path, arg, sub_type);
+        }
+
+        std::uint32_t fd = 0;
+        auto error = get_value(fd, arg, sub_type);
+        if (error.length() > 0 || fd > INT32_MAX)
+        {
+            return "must be a path string or file descriptor number. " + get_typeof_str(arg);
+        }
+
+        value.fd = static_cast<int>(fd);
+        return "";
+    }
+
+    template <>
+    inline std::string get_value(
+        SendOptions &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        if (!arg->IsObject())
+        {
+            return "must be an object. " + get_typeof_str(arg);
+        }
+
+        auto more = Nan::Get(arg.As<v8::Object>(), Nan::New("more").ToLocalChecked()).ToLocalChecked();
+        if (!more->IsUndefined())
+        {
+            auto error = get_value(value.more, more, sub_type);
+            if (error.length() > 0)
+            {
+                return "key \"more\" " + error;
+            }
+        }
+
+        return "";
+    }
+
+    template <>
+    inline std::string get_value(
+        HostPort &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        if (!arg->IsObject())
+        {
+            return "must be an object. " + get_typeof_str(arg);
+        }
+
+        auto object = arg.As<v8::Object>();
+        auto error = get_value(value.host, Nan::Get(object, Nan::New("host").ToLocalChecked()).ToLocalChecked(), sub_type);
+        if (error.length() > 0)
+        {
+            return "key \"host\" " + error;
+        }
+
+        error = get_value(value.port, Nan::Get(object, Nan::New("port").ToLocalChecked()).ToLocalChecked(), sub_type);
+        if (error.length() > 0)
+        {
+            return "key \"port\" " + error;
+        }
+
+        return "";
+    }
+
+    // Either a single piece of data to send, or an array of them to send
+    // back to back (as a header and payload, for example).
+    template <>
+    inline std::string get_value(
+        std::vector<SendableView> &value,
+        const v8::Local<v8::Value> &arg,
+        SubType sub_type)
+    {
+        if (!arg->IsArray())
+        {
+            value.resize(1);
+            return get_value(value[0], arg, sub_type);
+        }
+
+        auto array = arg.As<v8::Array>();
+        value.resize(array->Length());
+        for (std::uint32_t i = 0; i < value.size(); i++)
+        {
+            auto error = get_value(value[i], Nan::Get(array, i).ToLocalChecked(), sub_type);
+            if (error.length() > 0)
+            {
+                std::stringstream ss;
+                ss << "element " << i << " " << error;
+                return ss.str();
+            }
+        }
+
+        return "";
+    }
 } // namespace GetValue
 
 #endif
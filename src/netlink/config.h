@@ -27,6 +27,16 @@
 
 const size_t DEFAULT_LISTEN_QUEUE = 50;
 
+// milliseconds each address gets to connect before the next is also tried (RFC 8305)
+const unsigned DEFAULT_CONNECT_STAGGER = 250;
+
+// sends smaller than this are copied even in zero copy mode, as pinning their pages costs more
+const size_t DEFAULT_ZERO_COPY_THRESHOLD = 64 * 1024;
+
+// resolved names kept by the Resolver, and for how long (milliseconds)
+const size_t DEFAULT_RESOLVER_CACHE_SIZE = 256;
+const unsigned long long DEFAULT_RESOLVER_CACHE_TTL = 30 * 1000;
+
 const size_t DEFAULT_SMARTBUFFER_SIZE = 1024;
 const double DEFAULT_SMARTBUFFER_REALLOC_RATIO = 1.5;
 
@@ -102,6 +102,7 @@
 
 
 
+#include <netlink/resolver.h>
 #include <netlink/socket.h>
 #include <netlink/socket_group.h>
 
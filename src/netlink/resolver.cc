@@ -0,0 +1,406 @@
+#include "resolver.h"
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <unordered_map>
+
+
+NL_NAMESPACE
+
+
+namespace {
+
+    typedef std::chrono::steady_clock Clock;
+
+    struct CacheEntry {
+
+        string key;
+        std::vector<struct sockaddr_storage> addrs;
+        Clock::time_point expires;
+    };
+
+    struct Cache {
+
+        std::mutex mutex;
+        std::list<CacheEntry> entries;  // most recently used first
+        std::unordered_map<string, std::list<CacheEntry>::iterator> index;
+
+        size_t size = DEFAULT_RESOLVER_CACHE_SIZE;
+        unsigned long long ttl = DEFAULT_RESOLVER_CACHE_TTL;
+
+        unsigned long long hits = 0;
+        unsigned long long misses = 0;
+        std::atomic<unsigned long long> numeric{0};
+
+        void trim() {
+
+            while(entries.size() > size) {
+                index.erase(entries.back().key);
+                entries.pop_back();
+            }
+        }
+    };
+
+    Cache& cache() {
+
+        static Cache instance;
+        return instance;
+    }
+
+
+    int familyOf(IPVer ipVer) {
+
+        switch(ipVer) {
+
+            case IP4:
+                return AF_INET;
+
+            case IP6:
+                return AF_INET6;
+
+            case ANY:
+                return AF_UNSPEC;
+
+            default:
+                throw Exception(Exception::BAD_IP_VER, "Resolver::resolve: bad ip version parameter");
+        }
+    }
+
+
+    void setPort(struct sockaddr_storage& addr, unsigned port) {
+
+        if(addr.ss_family == AF_INET)
+            ((struct sockaddr_in*)&addr)->sin_port = htons(port);
+        else
+            ((struct sockaddr_in6*)&addr)->sin6_port = htons(port);
+    }
+
+
+    // inet_pton() parses literals of the requested family. A literal of the other family is
+    // left to getaddrinfo(), so it fails (or maps) exactly as before.
+    bool parseNumeric(const string& host, int family, std::vector<struct sockaddr_storage>& addrs) {
+
+        struct sockaddr_storage addr;
+        memset(&addr, 0, sizeof(addr));
+
+        if(family != AF_INET6 && inet_pton(AF_INET, host.c_str(), &((struct sockaddr_in*)&addr)->sin_addr) == 1) {
+            addr.ss_family = AF_INET;
+            addrs.push_back(addr);
+            return true;
+        }
+
+        if(family != AF_INET && inet_pton(AF_INET6, host.c_str(), &((struct sockaddr_in6*)&addr)->sin6_addr) == 1) {
+            addr.ss_family = AF_INET6;
+            addrs.push_back(addr);
+            return true;
+        }
+
+        return false;
+    }
+
+
+    // an empty host is the wildcard address to bind to
+    void lookup(const string& host, int family, std::vector<struct sockaddr_storage>& addrs) {
+
+        struct addrinfo conf, *res = NULL;
+        memset(&conf, 0, sizeof(conf));
+
+        conf.ai_family = family;
+        conf.ai_socktype = SOCK_DGRAM;  // only to get each address once
+        if(host.empty())
+            conf.ai_flags = AI_PASSIVE;
+
+        int status = getaddrinfo(host.empty() ? NULL : host.c_str(), "0", &conf, &res);
+
+        if(status != 0) {
+
+            string errorMsg = "Resolver::resolve: error resolving '" + host + "'";
+
+            #ifndef _MSC_VER
+                errorMsg += string(": ") + gai_strerror(status);
+            #endif
+
+            #ifdef OS_WIN32
+                int errorCode = WSAGetLastError();
+            #else
+                int errorCode = errno;
+            #endif
+
+            throw Exception(Exception::ERROR_SET_ADDR_INFO, errorMsg, errorCode);
+        }
+
+        for(struct addrinfo* info = res; info; info = info->ai_next) {
+
+            if(info->ai_family != AF_INET && info->ai_family != AF_INET6)
+                continue;
+
+            struct sockaddr_storage addr;
+            memset(&addr, 0, sizeof(addr));
+            memcpy(&addr, info->ai_addr, info->ai_addrlen);
+            addrs.push_back(addr);
+        }
+
+        freeaddrinfo(res);
+    }
+}
+
+
+/**
+* Resolves a host to the socket addresses to use for it
+*
+* Numeric hosts skip getaddrinfo(), and names are served from the cache while fresh.
+*
+* @param host Host name or numeric address. Empty for the wildcard address to bind to.
+* @param port Port to set in each address
+* @param ipVer IP version of the addresses: IP4, IP6 or ANY (both)
+* @param[out] addrs Here the function will store the addresses, in getaddrinfo() order
+* @throw Exception BAD_IP_VER, ERROR_SET_ADDR_INFO*
+*/
+
+void Resolver::resolve(const string& host, unsigned port, IPVer ipVer, std::vector<struct sockaddr_storage>& addrs) {
+
+    int family = familyOf(ipVer);
+    Cache& shared = cache();
+
+    addrs.clear();
+
+    if(!host.empty() && parseNumeric(host, family, addrs)) {
+        shared.numeric++;
+    }
+    else if(host.empty()) {
+        lookup(host, family, addrs);
+    }
+    else {
+
+        string key = string(1, (char)('0' + family)) + host;
+        bool found = false;
+
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            std::unordered_map<string, std::list<CacheEntry>::iterator>::iterator entry = shared.index.find(key);
+
+            if(entry != shared.index.end() && entry->second->expires > Clock::now()) {
+                shared.entries.splice(shared.entries.begin(), shared.entries, entry->second);
+                addrs = entry->second->addrs;
+                shared.hits++;
+                found = true;
+            }
+            else {
+                shared.misses++;
+            }
+        }
+
+        if(!found) {
+
+            // resolved without holding the lock, so slow lookups do not block cache hits
+            lookup(host, family, addrs);
+
+            std::lock_guard<std::mutex> lock(shared.mutex);
+
+            if(shared.size) {
+
+                std::unordered_map<string, std::list<CacheEntry>::iterator>::iterator entry = shared.index.find(key);
+
+                if(entry != shared.index.end()) {
+                    shared.entries.erase(entry->second);
+                    shared.index.erase(entry);
+                }
+
+                CacheEntry fresh;
+                fresh.key = key;
+                fresh.addrs = addrs;
+                fresh.expires = Clock::now() + std::chrono::milliseconds(shared.ttl);
+
+                shared.entries.push_front(fresh);
+                shared.index[key] = shared.entries.begin();
+                shared.trim();
+            }
+        }
+    }
+
+    for(size_t i = 0; i < addrs.size(); i++)
+        setPort(addrs[i], port);
+}
+
+
+/**
+* Resolves a host to the first socket address to use for it
+*
+* As resolve() above, without allocating for numeric hosts. Meant for a per datagram sendTo().
+*
+* @param host Host name or numeric address
+* @param port Port to set in the address
+* @param ipVer IP version of the address: IP4, IP6 or ANY (either)
+* @param[out] addr Here the function will store the address
+* @throw Exception BAD_IP_VER, ERROR_SET_ADDR_INFO*
+*/
+
+void Resolver::resolve(const string& host, unsigned port, IPVer ipVer, struct sockaddr_storage& addr) {
+
+    int family = familyOf(ipVer);
+
+    memset(&addr, 0, sizeof(addr));
+
+    if(!host.empty() && family != AF_INET6 && inet_pton(AF_INET, host.c_str(), &((struct sockaddr_in*)&addr)->sin_addr) == 1)
+        addr.ss_family = AF_INET;
+
+    else if(!host.empty() && family != AF_INET && inet_pton(AF_INET6, host.c_str(), &((struct sockaddr_in6*)&addr)->sin6_addr) == 1)
+        addr.ss_family = AF_INET6;
+
+    else {
+
+        std::vector<struct sockaddr_storage> addrs;
+        resolve(host, port, ipVer, addrs);
+
+        if(addrs.empty())
+            throw Exception(Exception::ERROR_SET_ADDR_INFO, "Resolver::resolve: no address found for '" + host + "'");
+
+        addr = addrs[0];
+        return;
+    }
+
+    cache().numeric++;
+    setPort(addr, port);
+}
+
+
+/**
+* Returns the size of an address, as the socket calls taking it expect
+*
+* @param addr An IPv4 or IPv6 address
+* @return size of the address (bytes)
+*/
+
+socklen_t Resolver::addressSize(const struct sockaddr_storage& addr) {
+
+    if (addr.ss_family == AF_INET)
+        return sizeof(struct sockaddr_in);
+
+    return sizeof(struct sockaddr_in6);
+}
+
+
+/**
+* Sets how many resolved names are cached, evicting the least recently used beyond it
+*
+* @param size Maximum number of cached names. 0 disables the cache.
+*/
+
+void Resolver::cacheSize(size_t size) {
+
+    Cache& shared = cache();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    shared.size = size;
+    shared.trim();
+}
+
+
+/**
+* Returns how many resolved names are cached at most
+*
+* @return maximum number of cached names
+*/
+
+size_t Resolver::cacheSize() {
+
+    Cache& shared = cache();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    return shared.size;
+}
+
+
+/**
+* Sets for how long resolved names are cached. Names already cached keep their expiry.
+*
+* @param ttl Time to live of each cached name (milliseconds)
+*/
+
+void Resolver::cacheTtl(unsigned long long ttl) {
+
+    Cache& shared = cache();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    shared.ttl = ttl;
+}
+
+
+/**
+* Returns for how long resolved names are cached
+*
+* @return time to live of each cached name (milliseconds)
+*/
+
+unsigned long long Resolver::cacheTtl() {
+
+    Cache& shared = cache();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    return shared.ttl;
+}
+
+
+/**
+* Forgets every cached name, so they are resolved again on next use
+*/
+
+void Resolver::clearCache() {
+
+    Cache& shared = cache();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    shared.entries.clear();
+    shared.index.clear();
+}
+
+
+/**
+* Returns how many names were served from the cache
+*
+* @return number of cache hits
+*/
+
+unsigned long long Resolver::cacheHits() {
+
+    Cache& shared = cache();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    return shared.hits;
+}
+
+
+/**
+* Returns how many names had to be resolved by getaddrinfo(), as they were not cached or
+* had expired
+*
+* @return number of cache misses
+*/
+
+unsigned long long Resolver::cacheMisses() {
+
+    Cache& shared = cache();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    return shared.misses;
+}
+
+
+/**
+* Returns how many numeric hosts were parsed directly, without resolving them
+*
+* @return number of numeric hosts
+*/
+
+unsigned long long Resolver::numericHits() {
+
+    return cache().numeric;
+}
+
+
+NL_NAMESPACE_END
@@ -0,0 +1,45 @@
+#ifndef __NL_RESOLVER
+#define __NL_RESOLVER
+
+#include "core.h"
+
+#include <vector>
+
+NL_NAMESPACE
+
+/**
+* @class Resolver resolver.h netlink/resolver.h
+*
+* Resolves hosts to socket addresses for every Socket.
+*
+* Numeric hosts (such as "10.0.0.5" or "::1") are parsed directly, without a getaddrinfo()
+* call. Names are kept in a bounded LRU cache for cacheTtl() milliseconds, as getaddrinfo()
+* does not expose the DNS record's own TTL. The cache is shared by all threads.
+*/
+
+class Resolver {
+
+    public:
+
+        static void resolve(const string& host, unsigned port, IPVer ipVer, std::vector<struct sockaddr_storage>& addrs);
+        static void resolve(const string& host, unsigned port, IPVer ipVer, struct sockaddr_storage& addr);
+        static socklen_t addressSize(const struct sockaddr_storage& addr);
+
+        static void cacheSize(size_t size);
+        static size_t cacheSize();
+        static void cacheTtl(unsigned long long ttl);
+        static unsigned long long cacheTtl();
+        static void clearCache();
+
+        static unsigned long long cacheHits();
+        static unsigned long long cacheMisses();
+        static unsigned long long numericHits();
+
+    private:
+
+        Resolver();
+};
+
+NL_NAMESPACE_END
+
+#endif
@@ -110,12 +110,36 @@ void SmartBuffer::read(Socket* socket) {
             freeBytes = _allocSize - _usedSize;
         }
 
-        _usedSize += socket->read((char*)_buffer + _usedSize, freeBytes);
+        int status = socket->read((char*)_buffer + _usedSize, freeBytes);
+
+        if(status <= 0)
+            break;
+
+        _usedSize += status;
 
     } while ((incomingBytes = socket->nextReadSize()));
 
 }
 
+/**
+* Removes data from the front of the buffer
+*
+* Discards the first bytes of the buffer, moving the remaining data to the front.
+*
+* @param bytes Amount of bytes to discard. If greater than size() the buffer is cleared.
+*/
+
+void SmartBuffer::erase(size_t bytes) {
+
+    if(bytes >= _usedSize) {
+        _usedSize = 0;
+        return;
+    }
+
+    _usedSize -= bytes;
+    memmove(_buffer, (char*)_buffer + bytes, _usedSize);
+}
+
 /**
 * Copy Operator.
 *
@@ -66,6 +66,7 @@ class SmartBuffer {
 
         void read(Socket* socket);
 
+        void erase(size_t bytes);
         void clear();
 
         SmartBuffer& operator=(SmartBuffer& s);
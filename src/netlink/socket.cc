@@ -21,9 +21,86 @@
 
 
 #include "socket.h"
+#include "resolver.h"
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <limits>
+
+
+#ifdef __linux__
+    #include <netinet/udp.h>
+    #include <linux/errqueue.h>
+    #include <sys/sendfile.h>
+
+    // datagrams per recvmmsg()/sendmmsg() call, their headers live on the stack
+    #define MANY_BATCH 64
+
+    // from linux/udp.h, which older libc headers do not expose
+    #ifndef SOL_UDP
+        #define SOL_UDP 17
+    #endif
+    #ifndef UDP_SEGMENT
+        #define UDP_SEGMENT 103
+    #endif
+    #ifndef UDP_GRO
+        #define UDP_GRO 104
+    #endif
+
+    // the kernel's UDP_MAX_SEGMENTS, the most segments one GSO send may carry
+    #define GSO_MAX_SEGMENTS 64
+    #define GSO_MAX_SIZE 65507
+
+    // from asm-generic/socket.h and linux/socket.h (4.14 or later)
+    #ifndef SO_ZEROCOPY
+        #define SO_ZEROCOPY 60
+    #endif
+    #ifndef MSG_ZEROCOPY
+        #define MSG_ZEROCOPY 0x4000000
+    #endif
+    #ifndef SO_EE_ORIGIN_ZEROCOPY
+        #define SO_EE_ORIGIN_ZEROCOPY 5
+    #endif
+    #ifndef SO_EE_CODE_ZEROCOPY_COPIED
+        #define SO_EE_CODE_ZEROCOPY_COPIED 1
+    #endif
+#endif
+
+#ifdef OS_WIN32
+    #include <io.h>
+    #include <fcntl.h>
+#endif
+
+// read and sent at a time when sendfile() can not be used
+#define SEND_FILE_CHUNK (16 * 1024)
+
+#ifndef OS_WIN32
+    #include <poll.h>
+#endif
+
+#ifdef OS_LINUX
+    #include <sys/uio.h>
+    #include <limits.h>
+    #include <netinet/tcp.h>
+
+    // buffers per sendmsg() call
+    #ifndef IOV_MAX
+        #define IOV_MAX 1024
+    #endif
+#endif
+
+#ifdef OS_WIN32
+    #define CONNECT_TIMED_OUT WSAETIMEDOUT
+#else
+    #define CONNECT_TIMED_OUT ETIMEDOUT
+#endif
+
+// only a hint, so platforms without it simply send right away
+#ifndef MSG_MORE
+    #define MSG_MORE 0
+#endif
 
 
 NL_NAMESPACE
@@ -36,11 +113,6 @@ NL_NAMESPACE
 	}
 
 
-	static void freeaddrinfo(struct addrinfo* addrInfo) {
-		(void)::freeaddrinfo(addrInfo);
-	}
-
-
 	static const char *inet_ntop(int af, const void *src, char *dst, socklen_t cnt)
 	{
 			if (af == AF_INET)
@@ -118,106 +190,317 @@ static void checkReadError(const string& functionName) {
 }
 
 
-void Socket::initSocket() {
+static void checkSendError(const string& functionName) {
 
-    struct addrinfo conf, *res = NULL;
-    memset(&conf, 0, sizeof(conf));
+    #ifdef OS_WIN32
+        if(WSAGetLastError() != WSAEWOULDBLOCK)
+            throw Exception(Exception::ERROR_SEND, string("Socket::") + functionName + ": error sending data", getSocketErrorCode());
+    #else
+        if(errno != EAGAIN && errno != EWOULDBLOCK)
+            throw Exception(Exception::ERROR_SEND, string("Socket::") + functionName + ": error sending data", getSocketErrorCode());
+    #endif
+}
 
-    if(_type == SERVER || _protocol == UDP)
-        conf.ai_flags = AI_PASSIVE;
 
+static int setHandleBlocking(int socketHandler, bool blocking) {
 
-    switch(_protocol) {
+    #ifdef OS_WIN32
 
-        case TCP:
-            conf.ai_socktype = SOCK_STREAM;
-            break;
+        u_long non_blocking = !blocking;
+        if(ioctlsocket(socketHandler, FIONBIO, &non_blocking) != 0)
+            return -1;
+        return 0;
+    #else
 
-        case UDP:
-            conf.ai_socktype = SOCK_DGRAM;
-            break;
+        int flags = fcntl(socketHandler, F_GETFL);
 
-        default:
-            throw Exception(Exception::BAD_PROTOCOL, "Socket::initSocket: bad protocol");
+        if(blocking)
+            return fcntl(socketHandler, F_SETFL, flags & ~O_NONBLOCK);
+        else
+            return fcntl(socketHandler, F_SETFL, flags | O_NONBLOCK);
+    #endif
+}
+
+
+static void setSocketErrorCode(int code) {
+
+    #ifdef OS_WIN32
+        WSASetLastError(code);
+    #else
+        errno = code;
+    #endif
+}
+
+
+#ifdef OS_WIN32
+    typedef WSAPOLLFD PollHandler;
+#else
+    typedef struct pollfd PollHandler;
+#endif
+
+
+static int pollHandlers(PollHandler* handlers, size_t count, int timeout) {
+
+    #ifdef OS_WIN32
+        return WSAPoll(handlers, (ULONG)count, timeout);
+    #else
+        return poll(handlers, (nfds_t)count, timeout);
+    #endif
+}
+
+
+static bool connectPending() {
+
+    #ifdef OS_WIN32
+        return WSAGetLastError() == WSAEWOULDBLOCK;
+    #else
+        return errno == EINPROGRESS;
+    #endif
+}
+
+
+static int getConnectError(int socketHandler) {
+
+    #ifdef OS_WIN32
+        char error = 0;
+        int errorSize = sizeof(error);
+    #else
+        int error = 0;
+        socklen_t errorSize = sizeof(error);
+    #endif
+
+    if(getsockopt(socketHandler, SOL_SOCKET, SO_ERROR, &error, &errorSize) == -1)
+        return getSocketErrorCode();
+
+    return error;
+}
+
+
+/*
+* Addresses in the order they are tried: the first family getaddrinfo preferred,
+* alternating with the other one (RFC 8305, section 4)
+*/
+
+static std::vector<size_t> interleaveFamilies(const std::vector<struct sockaddr_storage>& addrs) {
+
+    std::vector<size_t> preferred;
+    std::vector<size_t> other;
+
+    for(size_t i = 0; i < addrs.size(); i++)
+        (addrs[i].ss_family == addrs[0].ss_family ? preferred : other).push_back(i);
+
+    std::vector<size_t> order;
+
+    for(size_t i = 0; i < preferred.size() || i < other.size(); i++) {
+
+        if(i < preferred.size())
+            order.push_back(preferred[i]);
+
+        if(i < other.size())
+            order.push_back(other[i]);
     }
 
-    switch(_ipVer) {
+    return order;
+}
+
+
+/*
+* Connects to whichever of addrs accepts first, racing them "happy eyeballs" style
+* (RFC 8305): each attempt starts once the one before it has failed or had stagger
+* milliseconds to finish, the others are closed once one connects. Gives up once
+* deadline passes when timed.
+* Returns the connected socket, left blocking, and its index in addrs; or -1 with
+* the socket error code of the last failure set, CONNECT_TIMED_OUT when timed out.
+*/
+
+static int connectFirst(const std::vector<struct sockaddr_storage>& addrs, int socketType, unsigned stagger,
+                        bool timed, std::chrono::steady_clock::time_point deadline, size_t* connectedIndex)
+{
+    std::vector<size_t> order = interleaveFamilies(addrs);
+    std::vector<PollHandler> pending;
+    std::vector<size_t> pendingIndex;
+
+    size_t next = 0;
+    auto nextStart = std::chrono::steady_clock::now();
+    int error = 0;
+    int connected = -1;
+
+    while(connected == -1) {
+
+        auto now = std::chrono::steady_clock::now();
 
-        case IP4:
-            conf.ai_family = AF_INET;
+        if(timed && now >= deadline) {
+            error = CONNECT_TIMED_OUT;
             break;
+        }
+
+        if(next < order.size() && (pending.empty() || now >= nextStart)) {
+
+            size_t i = order[next++];
+
+            int socketHandler = socket(addrs[i].ss_family, socketType, 0);
 
-        case IP6:
-            conf.ai_family = AF_INET6;
+            if(socketHandler == -1) {
+                error = getSocketErrorCode();
+                continue;
+            }
+
+            if(setHandleBlocking(socketHandler, false) == -1) {
+                error = getSocketErrorCode();
+                close(socketHandler);
+                continue;
+            }
+
+            if(::connect(socketHandler, (const struct sockaddr*)&addrs[i], Resolver::addressSize(addrs[i])) != -1) {
+                connected = socketHandler;
+                *connectedIndex = i;
+                break;
+            }
+
+            if(!connectPending()) {
+                error = getSocketErrorCode();
+                close(socketHandler);
+                continue;
+            }
+
+            PollHandler handler;
+            handler.fd = socketHandler;
+            handler.events = POLLOUT;
+            handler.revents = 0;
+
+            pending.push_back(handler);
+            pendingIndex.push_back(i);
+            nextStart = now + std::chrono::milliseconds(stagger);
+            continue;
+        }
+
+        if(pending.empty())
             break;
 
-        case ANY:
-            conf.ai_family = AF_UNSPEC;
+        // wait for an attempt to finish, the next one to be due, or the deadline
+        int timeout = -1;
+
+        if(next < order.size())
+            timeout = (int)std::chrono::duration_cast<std::chrono::milliseconds>(nextStart - now).count() + 1;
+
+        if(timed) {
+            int remaining = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1;
+            if(timeout == -1 || remaining < timeout)
+                timeout = remaining;
+        }
+
+        int ready = pollHandlers(pending.data(), pending.size(), timeout);
+
+        if(ready == -1) {
+            #ifndef OS_WIN32
+                if(errno == EINTR)
+                    continue;
+            #endif
+            error = getSocketErrorCode();
             break;
+        }
 
-        default:
-            throw Exception(Exception::BAD_IP_VER, "Socket::initSocket: bad ip version parameter");
-    }
+        for(size_t p = 0; ready > 0 && p < pending.size(); ) {
 
+            if(!pending[p].revents) {
+                p++;
+                continue;
+            }
 
-    char portStr[10];
+            int socketHandler = (int)pending[p].fd;
+            int connectError = getConnectError(socketHandler);
 
-    const char* host;
+            if(!connectError && connected == -1) {
+                connected = socketHandler;
+                *connectedIndex = pendingIndex[p];
+            }
+            else {
+                if(connectError)
+                    error = connectError;
+                close(socketHandler);
 
-    if(_type == CLIENT && _protocol == TCP) {
-        host = _hostTo.c_str();
-        snprintf(portStr, 10, "%u", _portTo);
+                // a failed attempt lets the next one start right away
+                nextStart = now;
+            }
+
+            pending.erase(pending.begin() + p);
+            pendingIndex.erase(pendingIndex.begin() + p);
+        }
     }
-    else {
-        if(!_hostFrom.compare("") || !_hostFrom.compare("*"))
-            host = NULL;
-        else
-            host = _hostFrom.c_str();
 
-        snprintf(portStr, 10, "%u", _portFrom);
+    for(size_t p = 0; p < pending.size(); p++)
+        close((int)pending[p].fd);
+
+    if(connected != -1 && setHandleBlocking(connected, true) == -1) {
+        error = getSocketErrorCode();
+        close(connected);
+        connected = -1;
     }
 
-    int status = getaddrinfo(host, portStr, &conf, &res);
+    if(connected == -1)
+        setSocketErrorCode(error);
+
+    return connected;
+}
+
 
-    ReleaseManager<struct addrinfo> addrInfoReleaser(freeaddrinfo);
-    addrInfoReleaser.add(res);
+void Socket::initSocket() {
+
+    int socketType;
 
-    if(status != 0) {
+    switch(_protocol) {
 
-        string errorMsg = "Socket::initSocket: Error setting addrInfo: ";
+        case TCP:
+            socketType = SOCK_STREAM;
+            break;
 
-		#ifndef _MSC_VER
-			errorMsg += gai_strerror(status);
-		#endif
+        case UDP:
+            socketType = SOCK_DGRAM;
+            break;
 
-        throw Exception(Exception::ERROR_SET_ADDR_INFO, errorMsg, getSocketErrorCode());
+        default:
+            throw Exception(Exception::BAD_PROTOCOL, "Socket::initSocket: bad protocol");
     }
 
+    if(_ipVer != IP4 && _ipVer != IP6 && _ipVer != ANY)
+        throw Exception(Exception::BAD_IP_VER, "Socket::initSocket: bad ip version parameter");
+
+
+    std::vector<struct sockaddr_storage> addrs;
+
+    if(_type == CLIENT && _protocol == TCP)
+        Resolver::resolve(_hostTo, _portTo, _ipVer, addrs);
+
+    else
+        Resolver::resolve(_hostFrom.compare("*") ? _hostFrom : "", _portFrom, _ipVer, addrs);
+
     bool connected = false;
+    size_t connectedIndex = 0;
+
+    if(_type == CLIENT && _protocol == TCP) {
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_connectTimeout);
+
+        _socketHandler = connectFirst(addrs, socketType, _connectStagger, _connectTimeout != 0, deadline, &connectedIndex);
+        connected = _connected = _socketHandler != -1;
+    }
 
-    while(!connected && res) {
+    else for(size_t i = 0; !connected && i < addrs.size(); i++) {
 
-        _socketHandler = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+        const struct sockaddr* addr = (const struct sockaddr*)&addrs[i];
+        socklen_t addrSize = Resolver::addressSize(addrs[i]);
+
+        _socketHandler = socket(addrs[i].ss_family, socketType, 0);
 
         if(_socketHandler != -1)
 
             switch(_type) {
 
                 case CLIENT:
-                    if(_protocol == UDP) {
-
-                        if (bind(_socketHandler, res->ai_addr, res->ai_addrlen) == -1)
-                            close(_socketHandler);
-                        else
-                            connected = true;
-                    }
-                    else {
-                        status = connect(_socketHandler, res->ai_addr, res->ai_addrlen);
-                        if(status != -1)
-                            connected = true;
-                        else
-                            close(_socketHandler);
-                    }
+                    if (bind(_socketHandler, addr, addrSize) == -1)
+                        close(_socketHandler);
+                    else
+                        connected = true;
 
                     break;
 
@@ -231,7 +514,7 @@ void Socket::initSocket() {
                     if (setsockopt(_socketHandler, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(int)) == -1)
                         throw Exception(Exception::ERROR_SET_SOCK_OPT, "Socket::initSocket: Error establishing socket options");
 
-                    if (bind(_socketHandler, res->ai_addr, res->ai_addrlen) == -1)
+                    if (bind(_socketHandler, addr, addrSize) == -1)
                         close(_socketHandler);
                     else
                         connected = true;
@@ -243,8 +526,12 @@ void Socket::initSocket() {
 
             }
 
+        if(connected)
+            connectedIndex = i;
+    }
+
     if(connected && _ipVer == ANY)
-        switch(res->ai_family) {
+        switch(addrs[connectedIndex].ss_family) {
             case AF_INET:
                 _ipVer = IP4;
                 break;
@@ -254,9 +541,8 @@ void Socket::initSocket() {
                 break;
         }
 
-    res = res->ai_next;
-
-    }
+    if(!connected && getSocketErrorCode() == CONNECT_TIMED_OUT)
+        throw Exception(Exception::ERROR_CONNECT_SOCKET, "Socket::initSocket: timed out connecting", getSocketErrorCode());
 
     if(!connected)
         throw Exception(Exception::ERROR_CONNECT_SOCKET, "Socket::initSocket: error in socket connection/bind", getSocketErrorCode());
@@ -265,29 +551,46 @@ void Socket::initSocket() {
     if(!_portFrom)
         _portFrom = getLocalPort(_socketHandler);
 
-    //freeaddrinfo(res);
 }
 
 /**
 * CLIENT Socket constructor
 *
-* Creates a socket, connect it (if TCP) and sets it ready to send to hostTo:portTo.
+* Creates a socket and connects it to hostTo:portTo (a UDP socket, see connect()).
 * The local port of the socket is choosen by OS.
 *
 * @param hostTo the target/remote host
 * @param portTo the target/remote port
 * @param protocol the protocol to be used (TCP or UDP). TCP by default.
 * @param ipVer the IP version to be used (IP4, IP6 or ANY). ANY by default.
+* @param connectTimeout the milliseconds a TCP socket waits at most to connect, spread
+*   across every address hostTo resolves to. 0 (by default) waits as long as the OS does.
+* @param connectStagger the milliseconds a TCP socket gives each address hostTo resolves
+*   to before also trying the next one, alternating between IPv6 and IPv4 ones. The first
+*   to connect is kept (RFC 8305, "happy eyeballs").
 * @throw Exception BAD_PROTOCOL, BAD_IP_VER, ERROR_SET_ADDR_INFO*, ERROR_CONNECT_SOCKET*,
 *  ERROR_GET_ADDR_INFO*
 */
 
 
-Socket::Socket(const string& hostTo, unsigned portTo, Protocol protocol, IPVer ipVer) :
+Socket::Socket(const string& hostTo, unsigned portTo, Protocol protocol, IPVer ipVer, unsigned connectTimeout, unsigned connectStagger) :
                 _hostTo(hostTo), _portTo(portTo), _portFrom(0), _protocol(protocol),
-                _ipVer(ipVer), _type(CLIENT), _blocking(true), _listenQueue(0)
+                _ipVer(ipVer), _type(CLIENT), _blocking(true), _listenQueue(0), _connectTimeout(connectTimeout), _connectStagger(connectStagger), _gro(false), _cork(false), _connected(false)
 {
+    initReadAhead();
+    initZeroCopy();
+    initWriteQueue();
     initSocket();
+
+    if(_protocol == UDP) {
+        try {
+            connect(_hostTo, _portTo);
+        }
+        catch(...) {
+            close(_socketHandler);
+            throw;
+        }
+    }
 }
 
 
@@ -307,8 +610,11 @@ Socket::Socket(const string& hostTo, unsigned portTo, Protocol protocol, IPVer i
 
 Socket::Socket(unsigned portFrom, Protocol protocol, IPVer ipVer, const string& hostFrom, unsigned listenQueue):
                 _hostFrom(hostFrom), _portTo(0), _portFrom(portFrom), _protocol(protocol),
-                _ipVer(ipVer), _type(SERVER), _blocking(true), _listenQueue(listenQueue)
+                _ipVer(ipVer), _type(SERVER), _blocking(true), _listenQueue(listenQueue), _connectTimeout(0), _connectStagger(DEFAULT_CONNECT_STAGGER), _gro(false), _cork(false), _connected(false)
 {
+    initReadAhead();
+    initZeroCopy();
+    initWriteQueue();
     initSocket();
 }
 
@@ -316,7 +622,7 @@ Socket::Socket(unsigned portFrom, Protocol protocol, IPVer ipVer, const string&
 * UDP CLIENT Socket Constructor
 *
 * This client constructor for UDP Sockets allows to expecify the local port the socket
-* will be bound to. It sets the socket ready to send data to hostTo:portTo.
+* will be bound to. It connects the socket to hostTo:portTo, see connect().
 *
 * @param hostTo the target/remote host
 * @param portTo the target/remote port
@@ -328,14 +634,57 @@ Socket::Socket(unsigned portFrom, Protocol protocol, IPVer ipVer, const string&
 
 Socket::Socket(const string& hostTo, unsigned portTo, unsigned portFrom, IPVer ipVer):
                 _hostTo(hostTo), _portTo(portTo), _portFrom(portFrom), _protocol(UDP),
-                _ipVer(ipVer), _type(CLIENT), _blocking(true), _listenQueue(0)
+                _ipVer(ipVer), _type(CLIENT), _blocking(true), _listenQueue(0), _connectTimeout(0), _connectStagger(DEFAULT_CONNECT_STAGGER), _gro(false), _cork(false), _connected(false)
 {
-
+    initReadAhead();
+    initZeroCopy();
+    initWriteQueue();
     initSocket();
+
+    try {
+        connect(_hostTo, _portTo);
+    }
+    catch(...) {
+        close(_socketHandler);
+        throw;
+    }
+}
+
+
+Socket::Socket() : _blocking(true), _connectTimeout(0), _connectStagger(DEFAULT_CONNECT_STAGGER), _gro(false), _cork(false), _connected(false), _socketHandler(-1) {
+
+    initReadAhead();
+    initZeroCopy();
+    initWriteQueue();
+}
+
+
+void Socket::initReadAhead() {
+
+    _readAhead = NULL;
+    _readAheadCapacity = 0;
+    _readAheadStart = 0;
+    _readAheadSize = 0;
+    _readAheadRefills = 0;
+    _readAheadServed = 0;
 }
 
 
-Socket::Socket() : _blocking(true), _socketHandler(-1) {};
+void Socket::initZeroCopy() {
+
+    _zeroCopy = false;
+    _zeroCopyThreshold = DEFAULT_ZERO_COPY_THRESHOLD;
+    _zeroCopySent = 0;
+    _zeroCopyCompleted = 0;
+    _zeroCopyCopied = 0;
+}
+
+
+void Socket::initWriteQueue() {
+
+    _writeQueueEnabled = false;
+    _writeQueueStart = 0;
+}
 
 
 /**
@@ -349,6 +698,9 @@ Socket::~Socket() {
     if(_socketHandler != -1)
         close(_socketHandler);
 
+    if(_readAhead != NULL)
+        free(_readAhead);
+
 }
 
 
@@ -410,6 +762,7 @@ Socket* Socket::accept() {
     acceptSocket->_protocol = _protocol;
     acceptSocket->_ipVer = _ipVer;
     acceptSocket->_type = CLIENT;
+    acceptSocket->_connected = true;
     acceptSocket->_listenQueue = 0;
     acceptSocket->blocking(_blocking);
 
@@ -437,47 +790,38 @@ void Socket::sendTo(const void* buffer, size_t size, const string& hostTo, unsig
     if(_protocol != UDP)
         throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::sendTo: non-UDP socket can not 'sendTo'");
 
-    struct addrinfo conf, *res;
-    memset(&conf, 0, sizeof(conf));
-
-    conf.ai_socktype = SOCK_DGRAM;
-
-    switch(_ipVer) {
-
-        case IP4:
-            conf.ai_family = AF_INET;
-            break;
-
-        case IP6:
-            conf.ai_family = AF_INET6;
-            break;
+    struct sockaddr_storage addr;
+    resolveAddress(hostTo, portTo, &addr);
 
-        default:
-            throw Exception(Exception::BAD_IP_VER, "Socket::sendTo: bad ip version.");
-    }
+    sendTo(buffer, size, addr);
+}
 
-    char portStr[10];
-    snprintf(portStr, 10, "%u", portTo);
 
-    int status = getaddrinfo(hostTo.c_str(), portStr, &conf, &res);
+/**
+* Sends data to an already resolved address
+*
+* As sendTo() above, but the target address is given resolved, such as by resolveAddress(),
+* so nothing is looked up per datagram.
+*
+* @pre Socket must be UDP
+* @param buffer A pointer to the data we want to send
+* @param size Size of the data to send (bytes)
+* @param addrTo Target/remote address
+* @throw Exception EXPECTED_UDP_SOCKET, ERROR_SEND*
+*/
 
-    ReleaseManager<struct addrinfo> addrInfoReleaser(freeaddrinfo);
-    addrInfoReleaser.add(&res);
+void Socket::sendTo(const void* buffer, size_t size, const struct sockaddr_storage& addrTo) {
 
+    if(_protocol != UDP)
+        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::sendTo: non-UDP socket can not 'sendTo'");
 
-    if(status != 0) {
-        string errorMsg = "Socket::sendTo: error setting addrInfo: ";
-		#ifndef _MSC_VER
-			errorMsg += gai_strerror(status);
-		#endif
-		throw Exception(Exception::ERROR_SET_ADDR_INFO, "Socket::sendTo: error setting addr info", getSocketErrorCode());
-    }
+    socklen_t addrSize = Resolver::addressSize(addrTo);
 
     size_t sentBytes = 0;
 
     while(sentBytes < size) {
 
-        int status = ::sendto(_socketHandler, (const char*)buffer + sentBytes, size - sentBytes, 0, res->ai_addr, res->ai_addrlen);
+        int status = ::sendto(_socketHandler, (const char*)buffer + sentBytes, size - sentBytes, 0, (struct sockaddr *)&addrTo, addrSize);
 
         if(status == -1)
             throw Exception(Exception::ERROR_SEND, "Socket::sendTo: could not send the data", getSocketErrorCode());
@@ -487,95 +831,1194 @@ void Socket::sendTo(const void* buffer, size_t size, const string& hostTo, unsig
 }
 
 
-
-
 /**
-* Receive data and get the source host and port
+* Sends many buffers as one datagram (UDP Socket)
 *
-* Requires the socket to be UDP. Source host address and port are returned in hostFrom and
-* portFrom parameters. Data recieved is written in buffer address up to bufferSize.
+* Sends the concatenation of buffers to a given host:port as a single datagram, with one
+* sendmsg() call so the buffers are never copied together. On Windows, or when there are
+* more buffers than one call accepts, they are concatenated first.
 *
 * @pre Socket must be UDP
-* @param buffer Pointer to a buffer where received data will be stored
-* @param bufferSize Size of the buffer
-* @param[out] hostFrom Here the function will store the address of the remote host
-* @param[out] portFrom Here the function will store the remote port
-* @return the length of the data recieved
-* @throw Exception EXPECTED_UDP_SOCKET, ERROR_READ*
+* @param buffers Pointers to the data of each buffer
+* @param sizes Size of each buffer (bytes)
+* @param count Number of buffers
+* @param hostTo Target/remote host
+* @param portTo Target/remote port
+* @throw Exception EXPECTED_UDP_SOCKET, BAD_IP_VER, ERROR_SET_ADDR_INFO*, ERROR_SEND*
 */
 
-
-int Socket::readFrom(void* buffer, size_t bufferSize, string* hostFrom, unsigned* portFrom) {
+void Socket::sendTo(const void* const* buffers, const size_t* sizes, unsigned count, const string& hostTo, unsigned portTo) {
 
     if(_protocol != UDP)
-        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::readFrom: non-UDP socket can not 'readFrom'");
+        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::sendTo: non-UDP socket can not 'sendTo'");
 
     struct sockaddr_storage addr;
-    socklen_t addrSize = sizeof(addr);
-    int status = recvfrom(_socketHandler, (char*)buffer, bufferSize, 0, (struct sockaddr *)&addr, &addrSize);
-
-    if(status == -1) {
-        checkReadError("readFrom");
-        if(hostFrom)
-            *hostFrom = "";
-        if(portFrom)
-            *portFrom = 0;
-    }
-
-    else {
-
-        if(portFrom)
-            *portFrom = getInPort((struct sockaddr*)&addr);
-
-        if(hostFrom) {
-            char hostChar[INET6_ADDRSTRLEN];
-            inet_ntop(addr.ss_family, get_in_addr((struct sockaddr *)&addr), hostChar, sizeof hostChar);
-
-            *hostFrom = hostChar;
-        }
-    }
+    resolveAddress(hostTo, portTo, &addr);
 
-    return status;
+    sendTo(buffers, sizes, count, addr);
 }
 
 
 /**
-* Sends data
+* Sends many buffers as one datagram to an already resolved address
 *
-* Sends the data contained in buffer. Requires the Socket to be a CLIENT socket.
+* As sendTo() above, but the target address is given resolved, such as by resolveAddress().
 *
-* @pre Socket must be CLIENT
-* @param buffer A pointer to the data we want to send
+* @pre Socket must be UDP
+* @param buffers Pointers to the data of each buffer
+* @param sizes Size of each buffer (bytes)
+* @param count Number of buffers
+* @param addrTo Target/remote address
+* @throw Exception EXPECTED_UDP_SOCKET, ERROR_SEND*
+*/
+
+void Socket::sendTo(const void* const* buffers, const size_t* sizes, unsigned count, const struct sockaddr_storage& addrTo) {
+
+    if(_protocol != UDP)
+        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::sendTo: non-UDP socket can not 'sendTo'");
+
+  #ifdef OS_LINUX
+    if(count <= IOV_MAX) {
+
+        struct iovec iov[IOV_MAX];
+
+        for(unsigned i = 0; i < count; i++) {
+            iov[i].iov_base = (void*)buffers[i];
+            iov[i].iov_len = sizes[i];
+        }
+
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_name = (void*)&addrTo;
+        msg.msg_namelen = Resolver::addressSize(addrTo);
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        if(::sendmsg(_socketHandler, &msg, 0) == -1)
+            throw Exception(Exception::ERROR_SEND, "Socket::sendTo: could not send the data", getSocketErrorCode());
+
+        return;
+    }
+  #endif
+
+    string datagram;
+
+    for(unsigned i = 0; i < count; i++)
+        datagram.append((const char*)buffers[i], sizes[i]);
+
+    sendTo(datagram.data(), datagram.size(), addrTo);
+}
+
+
+/**
+* Sends data as many same size datagrams (UDP Socket)
+*
+* Splits buffer into datagrams of segmentSize bytes (the last may be shorter) and sends
+* them to a given host:port. On Linux the kernel does the split (UDP_SEGMENT, GSO), so up to
+* 64 datagrams are sent per system call. Elsewhere, or if the kernel does not support it,
+* each datagram is sent with its own sendto().
+*
+* @pre Socket must be UDP
+* @param buffer A pointer to the data we want to send
+* @param size Size of the data to send (bytes)
+* @param hostTo Target/remote host
+* @param portTo Target/remote port
+* @param segmentSize Size of each datagram (bytes)
+* @throw Exception EXPECTED_UDP_SOCKET, OUT_OF_RANGE, BAD_IP_VER, ERROR_SET_ADDR_INFO*, ERROR_SEND*
+*/
+
+void Socket::sendToSegmented(const void* buffer, size_t size, const string& hostTo, unsigned portTo, unsigned segmentSize) {
+
+    if(_protocol != UDP)
+        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::sendToSegmented: non-UDP socket can not 'sendToSegmented'");
+
+    struct sockaddr_storage addr;
+    resolveAddress(hostTo, portTo, &addr);
+
+    sendToSegmented(buffer, size, addr, segmentSize);
+}
+
+
+/**
+* Sends data as many same size datagrams to an already resolved address
+*
+* As sendToSegmented() above, but the target address is given resolved, such as by
+* resolveAddress().
+*
+* @pre Socket must be UDP
+* @param buffer A pointer to the data we want to send
+* @param size Size of the data to send (bytes)
+* @param addrTo Target/remote address
+* @param segmentSize Size of each datagram (bytes)
+* @throw Exception EXPECTED_UDP_SOCKET, OUT_OF_RANGE, ERROR_SEND*
+*/
+
+void Socket::sendToSegmented(const void* buffer, size_t size, const struct sockaddr_storage& addrTo, unsigned segmentSize) {
+
+    if(_protocol != UDP)
+        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::sendToSegmented: non-UDP socket can not 'sendToSegmented'");
+
+    if(segmentSize == 0)
+        throw Exception(Exception::OUT_OF_RANGE, "Socket::sendToSegmented: segment size must be greater than 0");
+
+    socklen_t addrSize = Resolver::addressSize(addrTo);
+
+    size_t sentBytes = 0;
+
+    #ifdef __linux__
+
+        size_t maxSegments = GSO_MAX_SIZE / segmentSize;
+        if(maxSegments > GSO_MAX_SEGMENTS)
+            maxSegments = GSO_MAX_SEGMENTS;
+
+        // a single segment gains nothing from GSO
+        bool useGso = maxSegments > 1 && size > segmentSize;
+
+        while(useGso && sentBytes < size) {
+
+            size_t chunk = size - sentBytes;
+            if(chunk > maxSegments * segmentSize)
+                chunk = maxSegments * segmentSize;
+
+            struct iovec iov;
+            iov.iov_base = (char*)buffer + sentBytes;
+            iov.iov_len = chunk;
+
+            union {
+                char buf[CMSG_SPACE(sizeof(uint16_t))];
+                struct cmsghdr align;
+            } control;
+            memset(control.buf, 0, sizeof(control.buf));
+            struct msghdr msg;
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_name = (void*)&addrTo;
+            msg.msg_namelen = addrSize;
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+
+            if(chunk > segmentSize) {
+                msg.msg_control = control.buf;
+                msg.msg_controllen = sizeof(control.buf);
+
+                struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+                cmsg->cmsg_level = SOL_UDP;
+                cmsg->cmsg_type = UDP_SEGMENT;
+                cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                uint16_t gsoSize = segmentSize;
+                memcpy(CMSG_DATA(cmsg), &gsoSize, sizeof(gsoSize));
+            }
+
+            int status = ::sendmsg(_socketHandler, &msg, 0);
+
+            if(status == -1) {
+                // kernels before 4.18, or devices without checksum offload
+                if(sentBytes == 0 && (errno == EINVAL || errno == ENOPROTOOPT || errno == EIO)) {
+                    useGso = false;
+                    break;
+                }
+                throw Exception(Exception::ERROR_SEND, "Socket::sendToSegmented: could not send the data", getSocketErrorCode());
+            }
+
+            sentBytes += chunk;
+        }
+
+    #endif
+
+    while(sentBytes < size) {
+
+        size_t chunk = size - sentBytes;
+        if(chunk > segmentSize)
+            chunk = segmentSize;
+
+        int status = ::sendto(_socketHandler, (const char*)buffer + sentBytes, chunk, 0, (struct sockaddr *)&addrTo, addrSize);
+
+        if(status == -1)
+            throw Exception(Exception::ERROR_SEND, "Socket::sendToSegmented: could not send the data", getSocketErrorCode());
+
+        sentBytes += chunk;
+    }
+}
+
+
+/**
+* Sends many datagrams at once (UDP Socket)
+*
+* Sends buffers[i] (of sizes[i] bytes) to addrsTo[i] for each of the count datagrams.
+* On Linux this is done with a single sendmmsg() call (one per MANY_BATCH datagrams),
+* elsewhere it falls back to sendto() for each datagram.
+* Stops at the first datagram that can not be sent, such as when a non-blocking
+* Socket's send buffer is full.
+*
+* @pre Socket must be UDP
+* @param buffers Array of pointers to the data of each datagram
+* @param sizes Array of the size of each datagram (bytes)
+* @param addrsTo Array of the target address of each datagram, as filled in by resolveAddress()
+* @param count Number of datagrams to send
+* @return Number of datagrams accepted by the kernel
+* @throw Exception EXPECTED_UDP_SOCKET, ERROR_SEND*
+*/
+
+int Socket::sendToMany(const void* const* buffers, const size_t* sizes, const struct sockaddr_storage* const* addrsTo, unsigned count) {
+
+    if(_protocol != UDP)
+        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::sendToMany: non-UDP socket can not 'sendToMany'");
+
+    unsigned sent = 0;
+
+    #ifdef __linux__
+
+        struct mmsghdr msgs[MANY_BATCH];
+        struct iovec iovecs[MANY_BATCH];
+
+        while(sent < count) {
+
+            unsigned batch = count - sent;
+            if(batch > MANY_BATCH)
+                batch = MANY_BATCH;
+
+            memset(msgs, 0, sizeof(struct mmsghdr) * batch);
+
+            for(unsigned i = 0; i < batch; i++) {
+                const struct sockaddr_storage* addr = addrsTo[sent + i];
+
+                iovecs[i].iov_base = (void*)buffers[sent + i];
+                iovecs[i].iov_len = sizes[sent + i];
+                msgs[i].msg_hdr.msg_iov = &iovecs[i];
+                msgs[i].msg_hdr.msg_iovlen = 1;
+                msgs[i].msg_hdr.msg_name = (void*)addr;
+                msgs[i].msg_hdr.msg_namelen = Resolver::addressSize(*addr);
+            }
+
+            int status = sendmmsg(_socketHandler, msgs, batch, 0);
+
+            if(status == -1) {
+                if(sent || errno == EAGAIN || errno == EWOULDBLOCK)
+                    break;
+                throw Exception(Exception::ERROR_SEND, "Socket::sendToMany: could not send the data", getSocketErrorCode());
+            }
+
+            sent += status;
+
+            if((unsigned)status < batch)
+                break;
+        }
+
+    #else
+
+        for(; sent < count; sent++) {
+
+            const struct sockaddr_storage* addr = addrsTo[sent];
+            int status = ::sendto(_socketHandler, (const char*)buffers[sent], sizes[sent], 0, (struct sockaddr *)addr, Resolver::addressSize(*addr));
+
+            if(status == -1) {
+                if(sent)
+                    break;
+                #ifdef OS_WIN32
+                    if(WSAGetLastError() == WSAEWOULDBLOCK)
+                        break;
+                #else
+                    if(errno == EAGAIN || errno == EWOULDBLOCK)
+                        break;
+                #endif
+                throw Exception(Exception::ERROR_SEND, "Socket::sendToMany: could not send the data", getSocketErrorCode());
+            }
+        }
+
+    #endif
+
+    return (int)sent;
+}
+
+
+/**
+* Connects a UDP socket to a single peer
+*
+* The kernel then keeps the peer's address, so send() and read() use plain send()/recv()
+* with no per datagram address, and datagrams from any other host are discarded. Errors
+* reported for the peer (such as ICMP port unreachable) fail the next send() or read().
+* May be called again to connect to another peer.
+*
+* @pre Socket must be UDP
+* @param hostTo Target/remote host
+* @param portTo Target/remote port
+* @throw Exception EXPECTED_UDP_SOCKET, BAD_IP_VER, ERROR_SET_ADDR_INFO*, ERROR_CONNECT_SOCKET*
+*/
+
+void Socket::connect(const string& hostTo, unsigned portTo) {
+
+    if(_protocol != UDP)
+        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::connect: non-UDP socket can not 'connect'");
+
+    struct sockaddr_storage addr;
+    resolveAddress(hostTo, portTo, &addr);
+
+    connect(addr);
+    _hostTo = hostTo;
+}
+
+
+/**
+* Connects a UDP socket to a single, already resolved, peer
+*
+* As connect() above, but the peer's address is given resolved, such as by resolveAddress().
+*
+* @pre Socket must be UDP
+* @param addrTo Target/remote address
+* @throw Exception EXPECTED_UDP_SOCKET, ERROR_CONNECT_SOCKET*
+*/
+
+void Socket::connect(const struct sockaddr_storage& addrTo) {
+
+    if(_protocol != UDP)
+        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::connect: non-UDP socket can not 'connect'");
+
+    if(::connect(_socketHandler, (const struct sockaddr*)&addrTo, Resolver::addressSize(addrTo)) == -1)
+        throw Exception(Exception::ERROR_CONNECT_SOCKET, "Socket::connect: could not connect the socket", getSocketErrorCode());
+
+    _hostTo = hostFromAddress(addrTo);
+    _portTo = portFromAddress(addrTo);
+    _connected = true;
+}
+
+
+/**
+* Resolves a host:port this Socket can send to
+*
+* Requires the socket to be UDP, as the address matches its IP version.
+*
+* @param hostTo Target/remote host
+* @param portTo Target/remote port
+* @param[out] addr Here the function will store the resolved address
+* @param[out] addrSize Here the function will store the size of the resolved address, if not NULL
+* @throw Exception BAD_IP_VER, ERROR_SET_ADDR_INFO*
+*/
+
+void Socket::resolveAddress(const string& hostTo, unsigned portTo, struct sockaddr_storage* addr, socklen_t* addrSize) const {
+
+    if(_ipVer != IP4 && _ipVer != IP6)
+        throw Exception(Exception::BAD_IP_VER, "Socket::resolveAddress: bad ip version.");
+
+    Resolver::resolve(hostTo, portTo, _ipVer, *addr);
+
+    if(addrSize)
+        *addrSize = Resolver::addressSize(*addr);
+}
+
+
+
+
+/**
+* Receive data and get the source host and port
+*
+* Requires the socket to be UDP. Source host address and port are returned in hostFrom and
+* portFrom parameters. Data recieved is written in buffer address up to bufferSize.
+*
+* @pre Socket must be UDP
+* @param buffer Pointer to a buffer where received data will be stored
+* @param bufferSize Size of the buffer
+* @param[out] hostFrom Here the function will store the address of the remote host
+* @param[out] portFrom Here the function will store the remote port
+* @param[out] segmentSize If not NULL, here the function will store the size of each
+*  datagram GRO coalesced into the data received, or its whole length if none were
+* @param[out] truncated If not NULL, here the function will store whether the datagram was
+*  larger than bufferSize, in which case the rest of it was discarded
+* @return the length of the data recieved
+* @throw Exception EXPECTED_UDP_SOCKET, ERROR_READ*
+*/
+
+
+int Socket::readFrom(void* buffer, size_t bufferSize, string* hostFrom, unsigned* portFrom, unsigned* segmentSize, bool* truncated) {
+
+    struct sockaddr_storage addr;
+    int status = readFrom(buffer, bufferSize, &addr, segmentSize, truncated);
+
+    if(status == -1) {
+        if(hostFrom)
+            *hostFrom = "";
+        if(portFrom)
+            *portFrom = 0;
+    }
+
+    else {
+
+        if(portFrom)
+            *portFrom = portFromAddress(addr);
+
+        if(hostFrom)
+            *hostFrom = hostFromAddress(addr);
+    }
+
+    return status;
+}
+
+
+/**
+* Receive data and get the source address
+*
+* Like readFrom() with a host string, but the source address is returned as is in addrFrom,
+* skipping formatting it as a string. Use hostFromAddress() and portFromAddress() to read it.
+*
+* @pre Socket must be UDP
+* @param buffer Pointer to a buffer where received data will be stored
+* @param bufferSize Size of the buffer
+* @param[out] addrFrom Here the function will store the address of the remote host and port,
+*  its family is AF_UNSPEC when nothing was received
+* @param[out] segmentSize If not NULL, here the function will store the size of each
+*  datagram GRO coalesced into the data received, or its whole length if none were
+* @param[out] truncated If not NULL, here the function will store whether the datagram was
+*  larger than bufferSize, in which case the rest of it was discarded
+* @return the length of the data recieved
+* @throw Exception EXPECTED_UDP_SOCKET, ERROR_READ*
+*/
+
+
+int Socket::readFrom(void* buffer, size_t bufferSize, struct sockaddr_storage* addrFrom, unsigned* segmentSize, bool* truncated) {
+
+    if(_protocol != UDP)
+        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::readFrom: non-UDP socket can not 'readFrom'");
+
+    struct sockaddr_storage& addr = *addrFrom;
+    socklen_t addrSize = sizeof(addr);
+    int status;
+
+    if(truncated)
+        *truncated = false;
+
+    #ifdef OS_WIN32
+
+        status = recvfrom(_socketHandler, (char*)buffer, bufferSize, 0, (struct sockaddr *)&addr, &addrSize);
+
+        if(status == -1 && WSAGetLastError() == WSAEMSGSIZE) {
+            // the buffer was filled with the start of the datagram, the rest is discarded
+            status = bufferSize;
+            if(truncated)
+                *truncated = true;
+        }
+
+        if(segmentSize && status != -1)
+            *segmentSize = status;
+
+    #else
+
+        if(segmentSize || truncated) {
+
+            // recvmsg() so truncation is flagged, and the GRO segment size comes along as a cmsg
+            struct iovec iov;
+            iov.iov_base = buffer;
+            iov.iov_len = bufferSize;
+
+            struct msghdr msg;
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_name = &addr;
+            msg.msg_namelen = addrSize;
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+
+            #ifdef __linux__
+                union {
+                    char buf[CMSG_SPACE(sizeof(int))];
+                    struct cmsghdr align;
+                } control;
+                msg.msg_control = control.buf;
+                msg.msg_controllen = sizeof(control.buf);
+            #endif
+
+            status = recvmsg(_socketHandler, &msg, 0);
+
+            if(status != -1) {
+
+                if(truncated)
+                    *truncated = (msg.msg_flags & MSG_TRUNC) != 0;
+
+                if(segmentSize)
+                    *segmentSize = status;
+
+                #ifdef __linux__
+                    for(struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); segmentSize && cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+                        if(cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                            int gsoSize;
+                            memcpy(&gsoSize, CMSG_DATA(cmsg), sizeof(gsoSize));
+                            *segmentSize = gsoSize;
+                        }
+                    }
+                #endif
+            }
+        }
+        else
+            status = recvfrom(_socketHandler, (char*)buffer, bufferSize, 0, (struct sockaddr *)&addr, &addrSize);
+
+    #endif
+
+    if(status == -1) {
+        checkReadError("readFrom");
+        addr.ss_family = AF_UNSPEC;
+        if(segmentSize)
+            *segmentSize = 0;
+    }
+
+    return status;
+}
+
+
+/**
+* Receives many datagrams at once (UDP Socket)
+*
+* Receives up to maxDatagrams datagrams, storing the i-th one at buffer + i * slotSize
+* and its length in lengths[i]. Datagrams larger than slotSize are truncated.
+* On Linux this is done with a single recvmmsg() call (one per MANY_BATCH datagrams),
+* elsewhere it falls back to recvfrom() while more data is queued.
+* Blocking sockets wait for the first datagram only.
+*
+* @pre Socket must be UDP
+* @param buffer A pointer to a buffer of at least slotSize * maxDatagrams bytes
+* @param slotSize Space reserved for each datagram (bytes)
+* @param maxDatagrams Max number of datagrams to receive
+* @param lengths Array of at least maxDatagrams where each datagram's size will be stored
+* @param addrsFrom Optional array of at least maxDatagrams where each datagram's source address will be stored
+* @param segmentSizes Optional array of at least maxDatagrams where the size of the datagrams
+*   coalesced into each received one by GRO will be stored, its length when not coalesced
+* @return Number of datagrams received, 0 if Socket is non-blocking and there's no data received
+* @throw Exception EXPECTED_UDP_SOCKET, ERROR_READ*
+*/
+
+int Socket::readFromMany(void* buffer, size_t slotSize, unsigned maxDatagrams, size_t* lengths, struct sockaddr_storage* addrsFrom, unsigned* segmentSizes) {
+
+    if(_protocol != UDP)
+        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::readFromMany: non-UDP socket can not 'readFromMany'");
+
+    unsigned received = 0;
+
+    #ifdef __linux__
+
+        struct mmsghdr msgs[MANY_BATCH];
+        struct iovec iovecs[MANY_BATCH];
+        union {
+            char buf[CMSG_SPACE(sizeof(int))];
+            struct cmsghdr align;
+        } controls[MANY_BATCH];
+
+        while(received < maxDatagrams) {
+
+            unsigned batch = maxDatagrams - received;
+            if(batch > MANY_BATCH)
+                batch = MANY_BATCH;
+
+            memset(msgs, 0, sizeof(struct mmsghdr) * batch);
+
+            for(unsigned i = 0; i < batch; i++) {
+                iovecs[i].iov_base = (char*)buffer + (size_t)(received + i) * slotSize;
+                iovecs[i].iov_len = slotSize;
+                msgs[i].msg_hdr.msg_iov = &iovecs[i];
+                msgs[i].msg_hdr.msg_iovlen = 1;
+
+                if(addrsFrom) {
+                    msgs[i].msg_hdr.msg_name = &addrsFrom[received + i];
+                    msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+                }
+
+                if(segmentSizes) {
+                    msgs[i].msg_hdr.msg_control = controls[i].buf;
+                    msgs[i].msg_hdr.msg_controllen = sizeof(controls[i].buf);
+                }
+            }
+
+            // only the first batch may wait, and only for its first datagram
+            int flags = received ? MSG_DONTWAIT : (_blocking ? MSG_WAITFORONE : 0);
+            int status = recvmmsg(_socketHandler, msgs, batch, flags, NULL);
+
+            if(status == -1) {
+                if(received)
+                    break;
+                checkReadError("readFromMany");
+                return 0;
+            }
+
+            for(int i = 0; i < status; i++) {
+
+                lengths[received + i] = msgs[i].msg_len;
+
+                if(!segmentSizes)
+                    continue;
+
+                segmentSizes[received + i] = msgs[i].msg_len;
+
+                struct msghdr* msg = &msgs[i].msg_hdr;
+                for(struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+                    if(cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                        int gsoSize;
+                        memcpy(&gsoSize, CMSG_DATA(cmsg), sizeof(gsoSize));
+                        segmentSizes[received + i] = gsoSize;
+                    }
+                }
+            }
+
+            received += status;
+
+            if((unsigned)status < batch)
+                break;
+        }
+
+    #else
+
+        while(received < maxDatagrams) {
+
+            if(received && nextReadSize() < 1)
+                break;
+
+            struct sockaddr_storage addr;
+            socklen_t addrSize = sizeof(addr);
+            int status = recvfrom(_socketHandler, (char*)buffer + (size_t)received * slotSize,
+                slotSize, 0, (struct sockaddr *)&addr, &addrSize);
+
+            if(status == -1) {
+                if(received)
+                    break;
+                checkReadError("readFromMany");
+                return 0;
+            }
+
+            lengths[received] = status;
+            if(addrsFrom)
+                addrsFrom[received] = addr;
+            if(segmentSizes)
+                segmentSizes[received] = status;
+
+            received++;
+        }
+
+    #endif
+
+    return (int)received;
+}
+
+
+/**
+* Gets the host of an address, such as one filled in by readFromMany()
+*
+* @param addr An IPv4 or IPv6 address
+* @return The numeric host, e.g. "127.0.0.1"
+*/
+
+string Socket::hostFromAddress(const struct sockaddr_storage& addr) {
+
+    char hostChar[INET6_ADDRSTRLEN];
+    inet_ntop(addr.ss_family, get_in_addr((struct sockaddr *)&addr), hostChar, sizeof hostChar);
+
+    return hostChar;
+}
+
+
+/**
+* Gets the port of an address, such as one filled in by readFromMany()
+*
+* @param addr An IPv4 or IPv6 address
+* @return The port in host byte order
+*/
+
+unsigned Socket::portFromAddress(const struct sockaddr_storage& addr) {
+
+    return getInPort((struct sockaddr *)&addr);
+}
+
+
+/**
+* Sends data
+*
+* Sends the data contained in buffer. Requires the Socket to be a CLIENT socket, or a UDP
+* socket connected to a peer (see connect()), which sends it as one datagram.
+* Blocking sockets send all of it. Non-blocking TCP sockets send what the kernel accepts
+* without waiting, queueing the rest if the write queue is enabled (see writeQueue(bool)).
+* Data already queued is sent first, so while any remains queued new data is queued too.
+*
+* @pre Socket must be CLIENT or connected
+* @param buffer A pointer to the data we want to send
 * @param size Length of the data to be sent (bytes)
+* @param more true if more data follows soon (MSG_MORE, TCP on Linux), so it is held back
+*   until it fills a segment or a send without it follows; false by default
+* @return Size of the data written to the socket, which is less than size only on
+*   non-blocking sockets that could not take more
+* @throw Exception EXPECTED_CLIENT_SOCKET, ERROR_SEND*
+*/
+
+
+size_t Socket::send(const void* buffer, size_t size, bool more) {
+
+    if(_type != CLIENT && !_connected)
+        throw Exception(Exception::EXPECTED_CLIENT_SOCKET, "Socket::send: Expected client socket (socket with host and port target)");
+
+    if(_protocol == UDP) {
+
+        if(!_connected) {
+            sendTo(buffer, size, _hostTo, _portTo);
+            return size;
+        }
+
+        if(::send(_socketHandler, (const char*)buffer, size, 0) == -1) {
+            checkSendError("send");
+            return 0;
+        }
+
+        return size;
+    }
+
+    if(flush()) {
+        queueWrite(buffer, size);
+        return 0;
+    }
+
+    size_t sentData = 0;
+
+    while (sentData < size) {
+
+        int status = sendChunk((const char*)buffer + sentData, size - sentData, more ? MSG_MORE : 0);
+
+        if(status == -1) {
+            checkSendError("send");
+            break;
+        }
+
+        sentData += status;
+    }
+
+    queueWrite((const char*)buffer + sentData, size - sentData);
+    return sentData;
+}
+
+
+/**
+* Sends what it can of buffer with one system call, with the given flags, without copying it if in zero copy mode
+* and size reaches the threshold. Falls back to copying when the kernel can not pin any
+* more memory (ENOBUFS).
+*
+* @return Size of the data sent or (-1) on errors
+*/
+
+int Socket::sendChunk(const void* buffer, size_t size, int flags) {
+
+  #ifdef __linux__
+    if(_zeroCopy && size >= _zeroCopyThreshold) {
+
+        // keeps the error queue from growing while sending in bulk
+        reapZeroCopy();
+
+        int status = ::send(_socketHandler, buffer, size, flags | MSG_ZEROCOPY);
+
+        if(status != -1) {
+            _zeroCopySent++;
+            return status;
+        }
+
+        if(errno != ENOBUFS)
+            return status;
+    }
+  #endif
+
+    return ::send(_socketHandler, (const char*)buffer, size, flags);
+}
+
+
+/**
+* Sends many buffers
+*
+* Sends the buffers one after another, as if they had been concatenated. Requires the
+* Socket to be a CLIENT socket. On POSIX systems every call to sendmsg() sends as many
+* buffers as the kernel accepts, so a header and its payload leave in a single system call
+* (and a single segment, with Nagle's algorithm enabled). UDP sockets send the buffers as
+* one datagram.
+*
+* @pre Socket must be CLIENT or connected
+* @param buffers Pointers to the data of each buffer
+* @param sizes Size of each buffer (bytes)
+* @param count Number of buffers
+* @param more true if more data follows soon (MSG_MORE), see send(const void*, size_t, bool)
 * @throw Exception EXPECTED_CLIENT_SOCKET, ERROR_SEND*
 */
 
 
-void Socket::send(const void* buffer, size_t size) {
+size_t Socket::send(const void* const* buffers, const size_t* sizes, unsigned count, bool more) {
+
+    if(_type != CLIENT && !_connected)
+        throw Exception(Exception::EXPECTED_CLIENT_SOCKET, "Socket::send: Expected client socket (socket with host and port target)");
+
+    size_t totalSize = 0;
+    for(unsigned i = 0; i < count; i++)
+        totalSize += sizes[i];
+
+    if(_protocol == UDP) {
+
+        if(!_connected) {
+            sendTo(buffers, sizes, count, _hostTo, _portTo);
+            return totalSize;
+        }
+
+      #ifdef OS_LINUX
+        if(count <= IOV_MAX) {
+
+            struct iovec iov[IOV_MAX];
+
+            for(unsigned i = 0; i < count; i++) {
+                iov[i].iov_base = (void*)buffers[i];
+                iov[i].iov_len = sizes[i];
+            }
+
+            struct msghdr msg;
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = iov;
+            msg.msg_iovlen = count;
+
+            if(::sendmsg(_socketHandler, &msg, 0) == -1) {
+                checkSendError("send");
+                return 0;
+            }
+
+            return totalSize;
+        }
+      #endif
+
+        string datagram;
+
+        for(unsigned i = 0; i < count; i++)
+            datagram.append((const char*)buffers[i], sizes[i]);
+
+        return send(datagram.data(), datagram.size()) ? totalSize : 0;
+    }
+
+    size_t sentData = 0;
+
+  #ifdef OS_WIN32
+
+    unsigned next = 0;
+
+    while(next < count) {
+
+        size_t sent = send(buffers[next], sizes[next], more);
+        sentData += sent;
+
+        // the rest of that buffer is already queued (if enabled) behind what was sent
+        if(sent < sizes[next++])
+            break;
+    }
+
+    for(; next < count; next++)
+        queueWrite(buffers[next], sizes[next]);
+
+  #else
+
+    if(flush()) {
+        for(unsigned i = 0; i < count; i++)
+            queueWrite(buffers[i], sizes[i]);
+        return 0;
+    }
+
+    struct iovec iov[IOV_MAX];
+    unsigned next = 0;
+    unsigned filled = 0;
+
+    while (next < count || filled) {
+
+        while(next < count && filled < IOV_MAX) {
+            if(sizes[next]) {
+                iov[filled].iov_base = (void*)buffers[next];
+                iov[filled].iov_len = sizes[next];
+                filled++;
+            }
+            next++;
+        }
+
+        if(!filled)
+            break;
+
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = filled;
+
+        ssize_t status = ::sendmsg(_socketHandler, &msg, more ? MSG_MORE : 0);
+
+        if(status == -1) {
+            checkSendError("send");
+            break;
+        }
+
+        sentData += status;
+
+        // drop what was sent, resuming a partially sent buffer where it stopped
+        size_t sent = status;
+        unsigned done = 0;
+
+        while(done < filled && sent >= iov[done].iov_len) {
+            sent -= iov[done].iov_len;
+            done++;
+        }
+
+        if(done < filled) {
+            iov[done].iov_base = (char*)iov[done].iov_base + sent;
+            iov[done].iov_len -= sent;
+        }
+
+        memmove(iov, iov + done, (filled - done) * sizeof(struct iovec));
+        filled -= done;
+    }
+
+    for(unsigned i = 0; i < filled; i++)
+        queueWrite(iov[i].iov_base, iov[i].iov_len);
+
+    for(; next < count; next++)
+        queueWrite(buffers[next], sizes[next]);
+
+  #endif
+
+    return sentData;
+}
+
+
+/**
+* Enables or disables the write queue (TCP Socket)
+*
+* When enabled, data a non-blocking socket could not send right away is copied into a
+* queue, sent ahead of any later data by flush() or the next send. Disabling it keeps
+* data already queued, which is still sent first.
+*
+* @param writeQueue true to queue unsent data; false to leave it to the caller
+*/
+
+void Socket::writeQueue(bool writeQueue) {
+
+    _writeQueueEnabled = writeQueue;
+}
+
+
+/**
+* Sends data queued by non-blocking sends, as much as the socket accepts without
+* waiting (or all of it, if blocking).
+*
+* @return Size of the data still queued (bytes)
+* @throw Exception ERROR_SEND*
+*/
+
+size_t Socket::flush() {
+
+    while(_writeQueueStart < _writeQueue.size()) {
+
+        // never MSG_ZEROCOPY, as the queue's memory is reused
+        int status = ::send(_socketHandler, _writeQueue.data() + _writeQueueStart, _writeQueue.size() - _writeQueueStart, 0);
+
+        if(status == -1) {
+            checkSendError("flush");
+            break;
+        }
+
+        _writeQueueStart += status;
+    }
+
+    if(_writeQueueStart == _writeQueue.size()) {
+        _writeQueue.clear();
+        _writeQueueStart = 0;
+    }
+
+    return _writeQueue.size() - _writeQueueStart;
+}
+
+
+/**
+* Adds data to the end of the write queue, if enabled.
+*/
+
+void Socket::queueWrite(const void* buffer, size_t size) {
+
+    if(!_writeQueueEnabled || !size)
+        return;
+
+    // reclaim the front once most of the queue has been sent
+    if(_writeQueueStart > _writeQueue.size() / 2) {
+        _writeQueue.erase(0, _writeQueueStart);
+        _writeQueueStart = 0;
+    }
+
+    _writeQueue.append((const char*)buffer, size);
+}
+
+
+/**
+* Sends part of a file (TCP Socket)
+*
+* Sends up to length bytes of the file from offset on, stopping early at its end. On Linux
+* sendfile() moves the data from the page cache straight to the socket, so it is never
+* copied into user memory. Elsewhere, or for files sendfile() does not support, the file is
+* read and sent in chunks. A non-blocking socket sends only what it can take without waiting.
+*
+* @pre Socket must be a TCP CLIENT
+* @param fileHandle File descriptor of the file, open for reading
+* @param offset Position in the file to start sending from (bytes)
+* @param length Maximum size of the data to send (bytes)
+* @return Size of the data sent, which is less than length if the end of the file was reached
+*   or a non-blocking socket could not take more
+* @throw Exception EXPECTED_TCP_SOCKET, EXPECTED_CLIENT_SOCKET, OUT_OF_RANGE, ERROR_SEND*, ERROR_READ*
+*/
+
+size_t Socket::sendFile(int fileHandle, unsigned long long offset, size_t length) {
+
+    if(_protocol != TCP)
+        throw Exception(Exception::EXPECTED_TCP_SOCKET, "Socket::sendFile: non-TCP socket can not 'sendFile'");
 
     if(_type != CLIENT)
-        throw Exception(Exception::EXPECTED_CLIENT_SOCKET, "Socket::send: Expected client socket (socket with host and port target)");
+        throw Exception(Exception::EXPECTED_CLIENT_SOCKET, "Socket::sendFile: Expected client socket (socket with host and port target)");
+
+    // a narrower off_t (32-bit builds without _FILE_OFFSET_BITS=64) would silently truncate it
+  #ifdef OS_WIN32
+    if(offset > (unsigned long long)std::numeric_limits<__int64>::max())
+  #else
+    if(offset > (unsigned long long)std::numeric_limits<off_t>::max())
+  #endif
+        throw Exception(Exception::OUT_OF_RANGE, "Socket::sendFile: offset is beyond the largest file offset");
+
+    // queued data goes first, and the file is not queued behind it
+    if(flush())
+        return 0;
 
-    if(_protocol == UDP)
-        return sendTo(buffer, size, _hostTo, _portTo);
+  #ifdef __linux__
 
+    off_t position = offset;
     size_t sentData = 0;
 
-    while (sentData < size) {
+    while(sentData < length) {
 
-        int status = ::send(_socketHandler, (const char*)buffer + sentData, size - sentData, 0);
+        ssize_t status = ::sendfile(_socketHandler, fileHandle, &position, length - sentData);
 
-        if(status == -1)
-            throw Exception(Exception::ERROR_SEND, "Error sending data", getSocketErrorCode());
+        if(status == -1) {
+
+            // files sendfile() can not map, such as some special files
+            if(!sentData && (errno == EINVAL || errno == ENOSYS))
+                return sendFileChunks(fileHandle, offset, length);
+
+            checkSendError("sendFile");
+            break;
+        }
+
+        if(status == 0)
+            break; // end of file
 
         sentData += status;
     }
+
+    return sentData;
+
+  #else
+
+    return sendFileChunks(fileHandle, offset, length);
+
+  #endif
+}
+
+
+/**
+* Sends part of a file by path (TCP Socket)
+*
+* Opens the file, sends it as sendFile(int, unsigned long long, size_t) does, and closes it.
+*
+* @pre Socket must be a TCP CLIENT
+* @param path Path of the file to send
+* @param offset Position in the file to start sending from (bytes)
+* @param length Maximum size of the data to send (bytes)
+* @return Size of the data sent
+* @throw Exception EXPECTED_TCP_SOCKET, EXPECTED_CLIENT_SOCKET, OUT_OF_RANGE, ERROR_SEND*, ERROR_READ*
+*/
+
+size_t Socket::sendFile(const string& path, unsigned long long offset, size_t length) {
+
+  #ifdef OS_WIN32
+    int fileHandle = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+  #else
+    int fileHandle = ::open(path.c_str(), O_RDONLY);
+  #endif
+
+    if(fileHandle == -1)
+        throw Exception(Exception::ERROR_READ, "Socket::sendFile: could not open the file " + path, errno);
+
+    try {
+
+        size_t sentData = sendFile(fileHandle, offset, length);
+
+      #ifdef OS_WIN32
+        _close(fileHandle);
+      #else
+        ::close(fileHandle);
+      #endif
+
+        return sentData;
+    }
+    catch(...) {
+
+      #ifdef OS_WIN32
+        _close(fileHandle);
+      #else
+        ::close(fileHandle);
+      #endif
+
+        throw;
+    }
+}
+
+
+/**
+* Sends part of a file by reading it in chunks, for when sendfile() can not be used.
+*
+* @return Size of the data sent
+* @throw Exception ERROR_SEND*, ERROR_READ*
+*/
+
+size_t Socket::sendFileChunks(int fileHandle, unsigned long long offset, size_t length) {
+
+    char buffer[SEND_FILE_CHUNK];
+    size_t sentData = 0;
+
+    while(sentData < length) {
+
+        size_t chunk = length - sentData < sizeof(buffer) ? length - sentData : sizeof(buffer);
+
+      #ifdef OS_WIN32
+        int readSize = -1;
+        if(_lseeki64(fileHandle, offset + sentData, SEEK_SET) != -1)
+            readSize = _read(fileHandle, buffer, (unsigned)chunk);
+      #else
+        ssize_t readSize = ::pread(fileHandle, buffer, chunk, offset + sentData);
+      #endif
+
+        if(readSize == -1)
+            throw Exception(Exception::ERROR_READ, "Socket::sendFile: error reading the file", errno);
+
+        if(readSize == 0)
+            break; // end of file
+
+        size_t chunkSent = 0;
+
+        while(chunkSent < (size_t)readSize) {
+
+            int status = ::send(_socketHandler, buffer + chunkSent, readSize - chunkSent, 0);
+
+            if(status == -1) {
+
+                // the rest of the chunk is read again from the file on the next call
+                checkSendError("sendFile");
+                return sentData + chunkSent;
+            }
+
+            chunkSent += status;
+        }
+
+        sentData += chunkSent;
+    }
+
+    return sentData;
 }
 
+
 /**
 * Receives data
 *
 * Receives data and stores it in buffer until bufferSize reached.
+* If read-ahead is enabled, reads smaller than its capacity are served from the
+* read-ahead buffer, refilling it with a single large recv when empty.
 *
 * @param buffer A pointer to a buffer where received data will be stored
 * @param bufferSize Size of the buffer
@@ -586,6 +2029,46 @@ void Socket::send(const void* buffer, size_t size) {
 
 int Socket::read(void* buffer, size_t bufferSize) {
 
+    if(_readAheadCapacity && bufferSize < _readAheadCapacity) {
+
+        if(!_readAheadSize) {
+
+            int status = recv(_socketHandler, _readAhead, _readAheadCapacity, 0);
+
+            if(status == -1)
+                checkReadError("read");
+
+            if(status <= 0)
+                return status;
+
+            _readAheadRefills++;
+            _readAheadStart = 0;
+            _readAheadSize = status;
+        }
+
+        size_t served = _readAheadSize < bufferSize ? _readAheadSize : bufferSize;
+
+        memcpy(buffer, _readAhead + _readAheadStart, served);
+        _readAheadStart += served;
+        _readAheadSize -= served;
+        _readAheadServed += served;
+
+        return (int)served;
+    }
+
+    if(_readAheadSize) {
+
+        // large reads bypass the read-ahead buffer, after emptying it
+        size_t served = _readAheadSize;
+
+        memcpy(buffer, _readAhead + _readAheadStart, served);
+        _readAheadStart = 0;
+        _readAheadSize = 0;
+        _readAheadServed += served;
+
+        return (int)served;
+    }
+
     int status = recv(_socketHandler, (char*)buffer, bufferSize, 0);
 
     if(status == -1)
@@ -598,7 +2081,8 @@ int Socket::read(void* buffer, size_t bufferSize) {
 /**
 * Get next read() data size
 *
-* Get the size of the data (bytes) a call to read() or readFrom() can process
+* Get the size of the data (bytes) a call to read() or readFrom() can process,
+* including any data held in the read-ahead buffer
 *
 * @return size of data the next call to read/readFrom will receive
 * @throw Exception ERROR_IOCTL*
@@ -624,7 +2108,49 @@ int Socket::nextReadSize() const {
     if(status)
         throw Exception(Exception::ERROR_IOCTL, "Socket::nextReadSize: error ioctl", getSocketErrorCode());
 
-    return result;
+    return (int)(result + _readAheadSize);
+}
+
+
+/**
+* Sets the capacity of the read-ahead buffer
+*
+* When enabled, read() calls asking for less than capacity bytes are served from
+* a buffer refilled with a single recv of up to capacity bytes, instead of making
+* a system call each. Any data already buffered is kept.
+*
+* @pre Socket must be TCP
+* @param capacity Size of the read-ahead buffer in bytes. 0 disables read-ahead.
+* @throw Exception EXPECTED_TCP_SOCKET, OUT_OF_RANGE, ERROR_ALLOC
+*/
+
+void Socket::readAhead(size_t capacity) {
+
+    if(_protocol != TCP)
+        throw Exception(Exception::EXPECTED_TCP_SOCKET, "Socket::readAhead: only TCP sockets can read-ahead");
+
+    if(capacity < _readAheadSize)
+        throw Exception(Exception::OUT_OF_RANGE, "Socket::readAhead: capacity is less than the data already buffered");
+
+    char* newReadAhead = NULL;
+
+    if(capacity) {
+
+        newReadAhead = (char*)malloc(capacity);
+
+        if(!newReadAhead)
+            throw Exception(Exception::ERROR_ALLOC, "Socket::readAhead: memory alloc error");
+
+        if(_readAheadSize)
+            memcpy(newReadAhead, _readAhead + _readAheadStart, _readAheadSize);
+    }
+
+    if(_readAhead != NULL)
+        free(_readAhead);
+
+    _readAhead = newReadAhead;
+    _readAheadCapacity = capacity;
+    _readAheadStart = 0;
 }
 
 
@@ -641,26 +2167,231 @@ void Socket::blocking(bool blocking) {
 
     _blocking = blocking;
 
-    int result = -1;
+    if (setHandleBlocking(_socketHandler, blocking) == -1)
+        throw Exception(Exception::ERROR_IOCTL, "Socket::blocking: ioctl error", getSocketErrorCode());
+}
 
-    #ifdef OS_WIN32
 
-        u_long non_blocking = !blocking;
-        result = ioctlsocket(_socketHandler, FIONBIO, &non_blocking);
-        if(result!=0)
-            result = -1;
+/**
+* Enables or disables UDP generic receive offload (GRO)
+*
+* When enabled the kernel may coalesce many same size datagrams from the same
+* source into a single larger one, which readFrom() reports along with the size
+* of each original datagram. Only supported on Linux (4.20 or later).
+*
+* @pre Socket must be UDP
+* @param gro true to enable GRO; false to disable it
+* @throw Exception EXPECTED_UDP_SOCKET, ERROR_SET_SOCK_OPT*
+*/
+
+void Socket::gro(bool gro) {
+
+    if(_protocol != UDP)
+        throw Exception(Exception::EXPECTED_UDP_SOCKET, "Socket::gro: non-UDP socket can not use GRO");
+
+    #ifdef __linux__
+
+        int value = gro ? 1 : 0;
+        if(setsockopt(_socketHandler, SOL_UDP, UDP_GRO, &value, sizeof(value)) == -1)
+            throw Exception(Exception::ERROR_SET_SOCK_OPT, "Socket::gro: error setting socket option", getSocketErrorCode());
+
     #else
 
-        int flags = fcntl(_socketHandler, F_GETFL);
+        if(gro)
+            throw Exception(Exception::ERROR_SET_SOCK_OPT, "Socket::gro: GRO is not supported on this platform");
 
-        if(blocking)
-            result = fcntl(_socketHandler, F_SETFL, flags & ~O_NONBLOCK);
-        else
-            result = fcntl(_socketHandler, F_SETFL, flags | O_NONBLOCK);
     #endif
 
-    if (result == -1)
-        throw Exception(Exception::ERROR_IOCTL, "Socket::blocking: ioctl error", getSocketErrorCode());
+    _gro = gro;
+}
+
+
+/**
+* Corks or uncorks the socket (TCP Socket)
+*
+* While corked, sent data is held back until it fills whole segments, so many small sends
+* go out together. Uncorking sends whatever is held back right away. Supported on Linux
+* (TCP_CORK) and the BSDs and macOS (TCP_NOPUSH).
+*
+* @pre Socket must be TCP
+* @param cork true to cork the socket; false to uncork it
+* @throw Exception EXPECTED_TCP_SOCKET, ERROR_SET_SOCK_OPT*
+*/
+
+void Socket::cork(bool cork) {
+
+    if(_protocol != TCP)
+        throw Exception(Exception::EXPECTED_TCP_SOCKET, "Socket::cork: non-TCP socket can not be corked");
+
+    #if defined(TCP_CORK) || defined(TCP_NOPUSH)
+
+        #ifdef TCP_CORK
+            int option = TCP_CORK;
+        #else
+            int option = TCP_NOPUSH;
+        #endif
+
+        int value = cork ? 1 : 0;
+        if(setsockopt(_socketHandler, IPPROTO_TCP, option, &value, sizeof(value)) == -1)
+            throw Exception(Exception::ERROR_SET_SOCK_OPT, "Socket::cork: error setting socket option", getSocketErrorCode());
+
+    #else
+
+        if(cork)
+            throw Exception(Exception::ERROR_SET_SOCK_OPT, "Socket::cork: corking is not supported on this platform");
+
+    #endif
+
+    _cork = cork;
+}
+
+
+/**
+* Enables or disables zero copy sends (TCP Socket)
+*
+* When enabled, single buffer sends of at least zeroCopyThreshold() bytes pass MSG_ZEROCOPY, so the kernel
+* transmits straight from the sender's memory instead of copying it. That memory must then
+* not be changed or freed until zeroCopyCompleted() reports the send as done. Only supported
+* on Linux (4.14 or later).
+*
+* @pre Socket must be TCP
+* @param zeroCopy true to enable zero copy sends; false to disable them
+* @throw Exception EXPECTED_TCP_SOCKET, ERROR_SET_SOCK_OPT*
+*/
+
+void Socket::zeroCopy(bool zeroCopy) {
+
+    if(_protocol != TCP)
+        throw Exception(Exception::EXPECTED_TCP_SOCKET, "Socket::zeroCopy: non-TCP socket can not use zero copy sends");
+
+    #ifdef __linux__
+
+        // the option can not be turned off again, later sends just stop asking for it
+        int value = 1;
+        if(zeroCopy && !_zeroCopy && setsockopt(_socketHandler, SOL_SOCKET, SO_ZEROCOPY, &value, sizeof(value)) == -1)
+            throw Exception(Exception::ERROR_SET_SOCK_OPT, "Socket::zeroCopy: error setting socket option", getSocketErrorCode());
+
+    #else
+
+        if(zeroCopy)
+            throw Exception(Exception::ERROR_SET_SOCK_OPT, "Socket::zeroCopy: zero copy sends are not supported on this platform");
+
+    #endif
+
+    _zeroCopy = zeroCopy;
+}
+
+
+/**
+* Sets the size below which sends are copied, even in zero copy mode
+*
+* @param threshold Minimum size of a zero copy send (bytes)
+*/
+
+void Socket::zeroCopyThreshold(size_t threshold) {
+
+    _zeroCopyThreshold = threshold;
+}
+
+
+/**
+* Returns how many zero copy sends the kernel is done with
+*
+* Reads any pending completion notifications from the socket error queue first.
+* Completions arrive in the order the sends were made, so once this reaches n the memory
+* of the first n zero copy sends (see zeroCopySent()) may be reused.
+*
+* @return number of completed zero copy sends
+* @throw Exception ERROR_READ*
+*/
+
+unsigned long long Socket::zeroCopyCompleted() {
+
+    reapZeroCopy();
+    return _zeroCopyCompleted;
+}
+
+
+/**
+* Returns how many completed zero copy sends the kernel copied anyway
+*
+* This happens when the route can not send from user memory, such as over loopback.
+* If most are copied, zero copy mode only adds overhead on this connection.
+*
+* @return number of copied zero copy sends
+* @throw Exception ERROR_READ*
+*/
+
+unsigned long long Socket::zeroCopyCopied() {
+
+    reapZeroCopy();
+    return _zeroCopyCopied;
+}
+
+
+/**
+* Reads the zero copy completion notifications queued on the socket error queue
+* (MSG_ERRQUEUE, which never blocks). Each covers a range of send calls.
+*
+* @throw Exception ERROR_READ*
+*/
+
+void Socket::reapZeroCopy() {
+
+  #ifdef __linux__
+
+    if(_zeroCopySent == _zeroCopyCompleted)
+        return;
+
+    while(true) {
+
+        // a single IP(V6)_RECVERR message: the error, followed by the offending address
+        union {
+            char buf[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))];
+            struct cmsghdr align;
+        } control;
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control = control.buf;
+        msg.msg_controllen = sizeof(control.buf);
+
+        if(::recvmsg(_socketHandler, &msg, MSG_ERRQUEUE) == -1) {
+
+            if(errno == EAGAIN || errno == EWOULDBLOCK)
+                return;
+
+            throw Exception(Exception::ERROR_READ, "Socket::zeroCopyCompleted: error reading the error queue", getSocketErrorCode());
+        }
+
+        // the completed range would be lost, and zeroCopyCompleted() stall
+        if(msg.msg_flags & MSG_CTRUNC)
+            throw Exception(Exception::ERROR_READ, "Socket::zeroCopyCompleted: error queue message truncated");
+
+        for(struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+
+            if(!((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                    (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)))
+                continue;
+
+            if(cmsg->cmsg_len < CMSG_LEN(sizeof(struct sock_extended_err)))
+                continue;
+
+            struct sock_extended_err err;
+            memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+
+            if(err.ee_errno != 0 || err.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                continue;
+
+            // ee_info to ee_data is the (inclusive) range of completed send calls
+            unsigned long long completed = (unsigned)(err.ee_data - err.ee_info) + 1ULL;
+
+            _zeroCopyCompleted += completed;
+            if(err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+                _zeroCopyCopied += completed;
+        }
+    }
+
+  #endif
 }
 
 
@@ -49,13 +49,36 @@ class Socket {
         SocketType  _type;
         bool        _blocking;
         unsigned    _listenQueue;
+        unsigned    _connectTimeout;
+        unsigned    _connectStagger;
+        bool        _gro;
+        bool        _cork;
+        bool        _connected;
 
         int         _socketHandler;
 
+        char*       _readAhead;
+        size_t      _readAheadCapacity;
+        size_t      _readAheadStart;
+        size_t      _readAheadSize;
+        unsigned long long _readAheadRefills;
+        unsigned long long _readAheadServed;
+
+        bool        _zeroCopy;
+        size_t      _zeroCopyThreshold;
+        unsigned long long _zeroCopySent;
+        unsigned long long _zeroCopyCompleted;
+        unsigned long long _zeroCopyCopied;
+
+        bool        _writeQueueEnabled;
+        string      _writeQueue;
+        size_t      _writeQueueStart;
+
 
     public:
 
-        Socket(const string& hostTo, unsigned portTo, Protocol protocol = TCP, IPVer ipVer = ANY);
+        Socket(const string& hostTo, unsigned portTo, Protocol protocol = TCP, IPVer ipVer = ANY, unsigned connectTimeout = 0,
+               unsigned connectStagger = DEFAULT_CONNECT_STAGGER);
 
         Socket(unsigned portFrom, Protocol protocol = TCP, IPVer ipVer = IP4, const string& hostFrom = "", unsigned listenQueue = DEFAULT_LISTEN_QUEUE);
 
@@ -67,13 +90,48 @@ class Socket {
         Socket* accept();
 
         int read(void* buffer, size_t bufferSize);
-        void send(const void* buffer, size_t size);
-
-        int readFrom(void* buffer, size_t bufferSize, string* HostFrom, unsigned* portFrom = NULL);
+        size_t send(const void* buffer, size_t size, bool more = false);
+        size_t send(const void* const* buffers, const size_t* sizes, unsigned count, bool more = false);
+        size_t sendFile(int fileHandle, unsigned long long offset, size_t length);
+        size_t sendFile(const string& path, unsigned long long offset, size_t length);
+
+        int readFrom(void* buffer, size_t bufferSize, string* HostFrom, unsigned* portFrom = NULL, unsigned* segmentSize = NULL, bool* truncated = NULL);
+        int readFrom(void* buffer, size_t bufferSize, struct sockaddr_storage* addrFrom, unsigned* segmentSize = NULL, bool* truncated = NULL);
+        int readFromMany(void* buffer, size_t slotSize, unsigned maxDatagrams, size_t* lengths, struct sockaddr_storage* addrsFrom = NULL, unsigned* segmentSizes = NULL);
         void sendTo(const void* buffer, size_t size, const string& hostTo, unsigned portTo);
+        void sendTo(const void* buffer, size_t size, const struct sockaddr_storage& addrTo);
+        void sendTo(const void* const* buffers, const size_t* sizes, unsigned count, const string& hostTo, unsigned portTo);
+        void sendTo(const void* const* buffers, const size_t* sizes, unsigned count, const struct sockaddr_storage& addrTo);
+        void sendToSegmented(const void* buffer, size_t size, const string& hostTo, unsigned portTo, unsigned segmentSize);
+        void sendToSegmented(const void* buffer, size_t size, const struct sockaddr_storage& addrTo, unsigned segmentSize);
+        int sendToMany(const void* const* buffers, const size_t* sizes, const struct sockaddr_storage* const* addrsTo, unsigned count);
+
+        void connect(const string& hostTo, unsigned portTo);
+        void connect(const struct sockaddr_storage& addrTo);
+
+        void resolveAddress(const string& hostTo, unsigned portTo, struct sockaddr_storage* addr, socklen_t* addrSize = NULL) const;
 
         int nextReadSize() const;
 
+        void readAhead(size_t capacity);
+        size_t readAhead() const;
+        size_t readAheadBuffered() const;
+        unsigned long long readAheadRefills() const;
+        unsigned long long readAheadServed() const;
+
+        void zeroCopy(bool zeroCopy);
+        bool zeroCopy() const;
+        void zeroCopyThreshold(size_t threshold);
+        size_t zeroCopyThreshold() const;
+        unsigned long long zeroCopySent() const;
+        unsigned long long zeroCopyCompleted();
+        unsigned long long zeroCopyCopied();
+
+        void writeQueue(bool writeQueue);
+        bool writeQueue() const;
+        size_t writeQueueSize() const;
+        size_t flush();
+
         void disconnect();
 
         const string&   hostTo() const;
@@ -84,16 +142,33 @@ class Socket {
         IPVer           ipVer() const;
         SocketType      type() const;
         bool            blocking() const;
+        bool            gro() const;
+        bool            cork() const;
+        bool            connected() const;
         unsigned        listenQueue() const;
+        unsigned        connectTimeout() const;
+        unsigned        connectStagger() const;
         int             socketHandler() const;
 
 
         void blocking(bool blocking);
+        void gro(bool gro);
+        void cork(bool cork);
+
+        static string hostFromAddress(const struct sockaddr_storage& addr);
+        static unsigned portFromAddress(const struct sockaddr_storage& addr);
 
 
     private:
 
         void initSocket();
+        void initReadAhead();
+        void initZeroCopy();
+        void initWriteQueue();
+        void queueWrite(const void* buffer, size_t size);
+        void reapZeroCopy();
+        int sendChunk(const void* buffer, size_t size, int flags);
+        size_t sendFileChunks(int fileHandle, unsigned long long offset, size_t length);
         Socket();
 
 };
@@ -112,6 +112,29 @@ inline unsigned Socket::listenQueue() const {
     return _listenQueue;
 }
 
+/**
+* Returns how long a TCP CLIENT socket waited at most to connect
+*
+* @return the connect timeout in milliseconds, 0 when it waited as long as the OS does
+*/
+
+inline unsigned Socket::connectTimeout() const {
+
+    return _connectTimeout;
+}
+
+/**
+* Returns how long a TCP CLIENT socket gave each address it resolved to before
+* also trying the next one
+*
+* @return the connect stagger in milliseconds
+*/
+
+inline unsigned Socket::connectStagger() const {
+
+    return _connectStagger;
+}
+
 /**
 * Returns whether the socket is blocking (true) or not (false)
 *
@@ -123,6 +146,100 @@ inline bool Socket::blocking() const {
     return _blocking;
 }
 
+/**
+* Returns whether UDP generic receive offload is enabled (true) or not (false)
+*
+* @return socket GRO status
+*/
+
+inline bool Socket::gro() const {
+
+    return _gro;
+}
+
+/**
+* Returns whether the socket is corked (true) or not (false)
+*
+* @return socket cork status
+*/
+
+inline bool Socket::cork() const {
+
+    return _cork;
+}
+
+/**
+* Returns whether the socket is connected to a single peer (true) or not (false):
+* TCP CLIENT sockets always are, UDP sockets once connect() is called
+*
+* @return socket connection status
+*/
+
+inline bool Socket::connected() const {
+
+    return _connected;
+}
+
+
+/**
+* Returns whether large sends are made without copying them (MSG_ZEROCOPY) or not
+*
+* @return socket zero copy status
+*/
+
+inline bool Socket::zeroCopy() const {
+
+    return _zeroCopy;
+}
+
+/**
+* Returns the size below which sends are copied, even in zero copy mode
+*
+* @return zero copy threshold (bytes)
+*/
+
+inline size_t Socket::zeroCopyThreshold() const {
+
+    return _zeroCopyThreshold;
+}
+
+/**
+* Returns how many system calls sent data without copying it (MSG_ZEROCOPY)
+*
+* The memory sent by the first n such calls may be reused once zeroCopyCompleted()
+* reaches n.
+*
+* @return number of zero copy sends
+*/
+
+inline unsigned long long Socket::zeroCopySent() const {
+
+    return _zeroCopySent;
+}
+
+
+/**
+* Returns whether data non-blocking sends could not send is queued (true) or not (false)
+*
+* @return write queue status
+*/
+
+inline bool Socket::writeQueue() const {
+
+    return _writeQueueEnabled;
+}
+
+/**
+* Returns the size of the data queued to be sent by flush() or the next send
+*
+* @return size of the write queue (bytes)
+*/
+
+inline size_t Socket::writeQueueSize() const {
+
+    return _writeQueue.size() - _writeQueueStart;
+}
+
 
 /**
 * Returns the socket handler (file/socket descriptor)
@@ -136,6 +253,50 @@ inline int Socket::socketHandler() const {
     return _socketHandler;
 }
 
+/**
+* Returns the capacity of the read-ahead buffer
+*
+* @return read-ahead buffer capacity in bytes, 0 if read-ahead is disabled
+*/
+
+inline size_t Socket::readAhead() const {
+
+    return _readAheadCapacity;
+}
+
+/**
+* Returns the amount of data held in the read-ahead buffer
+*
+* @return bytes already received from the OS but not yet returned by read()
+*/
+
+inline size_t Socket::readAheadBuffered() const {
+
+    return _readAheadSize;
+}
+
+/**
+* Returns how many times the read-ahead buffer has been refilled
+*
+* @return number of recv calls made to refill the read-ahead buffer
+*/
+
+inline unsigned long long Socket::readAheadRefills() const {
+
+    return _readAheadRefills;
+}
+
+/**
+* Returns how much data read() has served from the read-ahead buffer
+*
+* @return bytes returned by read() from the read-ahead buffer
+*/
+
+inline unsigned long long Socket::readAheadServed() const {
+
+    return _readAheadServed;
+}
+
 #ifdef DOXYGEN
     NL_NAMESPACE_END
 #endif
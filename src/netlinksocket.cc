@@ -1,5 +1,8 @@
 #include <node.h>
+#include "buffer_pool.h"
+#include "endpoint.h"
 #include "netlinkwrapper.h"
+#include "resolver_wrapper.h"
 
 
 extern "C" NODE_MODULE_EXPORT
@@ -9,4 +12,7 @@ void NODE_MODULE_INITIALIZER(v8::Local<v8::Object> exports,
 {
     NL::init();
     NetLinkWrapper::init(exports);
+    BufferPool::init(exports);
+    Endpoint::init(exports);
+    ResolverWrapper::init(exports);
 }
@@ -1,17 +1,27 @@
 #define NOMINMAX
 #include <algorithm>
-#include <array>
 #include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <limits>
 #include <nan.h>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "arg_parser.h"
+#include "byte_scan.h"
+#include "connect_worker.h"
 #include "get_value.h"
 #include "netlinkwrapper.h"
 #include "netlink/exception.h"
+#include "string_decode.h"
 
 #define READ_SIZE 255
+// largest datagram a receiveFrom can be sized for, GRO can coalesce up to 64 KiB
+#define MAX_DATAGRAM_SIZE (64 * 1024)
+// elements of the Uint32Array receiveFromRaw writes a datagram's info to
+#define RAW_INFO_LENGTH 7
 
 v8::Persistent<v8::FunctionTemplate> NetLinkWrapper::class_socket_base;
 v8::Persistent<v8::FunctionTemplate> NetLinkWrapper::class_socket_tcp_client;
@@ -43,6 +53,63 @@ void throw_js_error(NL::Exception &err)
     isolate->ThrowException(v8::Exception::Error(v8_val));
 }
 
+void throw_js_range_error(const char *arg_name, std::uint32_t value, std::size_t max)
+{
+    auto isolate = v8::Isolate::GetCurrent();
+    std::stringstream ss;
+    ss << "Argument \"" << arg_name << "\" " << value
+       << " is out of range of the buffer (" << max << ").";
+
+    auto v8_val = v8_str(ss.str());
+    isolate->ThrowException(v8::Exception::RangeError(v8_val));
+}
+
+// Narrows a BufferView to the [offset, offset + length) window requested from
+// JS. Throws a RangeError and returns false when it does not fit.
+bool narrow_buffer_view(
+    GetValue::BufferView &view,
+    std::uint32_t offset,
+    std::uint32_t length,
+    bool has_length)
+{
+    if (offset > view.length)
+    {
+        throw_js_range_error("offset", offset, view.length);
+        return false;
+    }
+
+    auto available = view.length - offset;
+    if (!has_length)
+    {
+        length = static_cast<std::uint32_t>(std::min<std::size_t>(available, UINT32_MAX));
+    }
+    else if (length > available)
+    {
+        throw_js_range_error("length", length, available);
+        return false;
+    }
+
+    view.data += offset;
+    view.length = length;
+    return true;
+}
+
+// Splits the views into the parallel pointer and size arrays NL::Socket's
+// vectored sends take.
+void split_views(
+    const std::vector<GetValue::SendableView> &views,
+    std::vector<const void *> &buffers,
+    std::vector<std::size_t> &sizes)
+{
+    buffers.resize(views.size());
+    sizes.resize(views.size());
+    for (std::size_t i = 0; i < views.size(); i++)
+    {
+        buffers[i] = views[i].data();
+        sizes[i] = views[i].length();
+    }
+}
+
 NetLinkWrapper::NetLinkWrapper(NL::Socket *socket)
 {
     this->socket = socket;
@@ -64,6 +131,12 @@ NetLinkWrapper::~NetLinkWrapper()
         delete this->socket;
         this->socket = nullptr;
     }
+
+    if (this->frame_buffer != nullptr)
+    {
+        delete this->frame_buffer;
+        this->frame_buffer = nullptr;
+    }
 }
 
 bool NetLinkWrapper::throw_if_destroyed()
@@ -79,6 +152,100 @@ bool NetLinkWrapper::throw_if_destroyed()
     return true;
 }
 
+bool NetLinkWrapper::throw_if_wrong_ip_version(const Endpoint *endpoint)
+{
+    if (endpoint->ip_version == this->ip_version)
+    {
+        return false;
+    }
+
+    auto isolate = v8::Isolate::GetCurrent();
+    auto v8_val = v8_str(this->ip_version == NL::IPVer::IP6
+                             ? "Cannot use an IPv4 Endpoint with an IPv6 socket."
+                             : "Cannot use an IPv6 Endpoint with an IPv4 socket.");
+    isolate->ThrowException(v8::Exception::Error(v8_val));
+    return true;
+}
+
+// Moves up to size bytes of the frame buffer into buffer, so plain receives
+// never skip over data buffered for framed receives.
+std::size_t NetLinkWrapper::take_frame_buffer(char *buffer, std::size_t size)
+{
+    if (this->frame_buffer == nullptr || this->frame_buffer->size() == 0)
+    {
+        return 0;
+    }
+
+    auto length = std::min(size, this->frame_buffer->size());
+    memcpy(buffer, this->frame_buffer->buffer(), length);
+    this->frame_buffer->erase(length);
+    return length;
+}
+
+// Reads whatever is queued on the socket into frame_buffer. If nothing is queued
+// and wait is set, blocking sockets wait for data to arrive instead.
+// Returns true if any more data was read.
+bool NetLinkWrapper::fill_frame_buffer(bool wait)
+{
+    if (this->frame_buffer == nullptr)
+    {
+        this->frame_buffer = new NL::SmartBuffer();
+    }
+
+    if (this->socket->nextReadSize() < 1 && !(wait && this->socket->blocking()))
+    {
+        return false;
+    }
+
+    auto before = this->frame_buffer->size();
+    this->frame_buffer->read(this->socket);
+    return this->frame_buffer->size() != before;
+}
+
+// Appends up to max_bytes of whatever is in the frame buffer, or else queued
+// on the socket, to into. If nothing is queued, blocking sockets wait for data.
+// Returns true if any data was appended.
+bool NetLinkWrapper::read_into(std::vector<char> &into, std::size_t max_bytes)
+{
+    auto before = into.size();
+    if (this->frame_buffer != nullptr && this->frame_buffer->size() > 0)
+    {
+        auto length = std::min(this->frame_buffer->size(), max_bytes);
+        into.resize(before + length);
+        this->take_frame_buffer(into.data() + before, length);
+        return true;
+    }
+
+    auto next_read_size = this->socket->nextReadSize();
+    if (next_read_size < 1 && !this->socket->blocking())
+    {
+        return false;
+    }
+
+    std::size_t capacity = next_read_size > 0 ? next_read_size : READ_SIZE;
+    capacity = std::min(capacity, max_bytes);
+    into.resize(before + capacity);
+
+    auto read = this->socket->read(into.data() + before, capacity);
+    into.resize(before + std::max(read, 0));
+    return read > 0;
+}
+
+// Frees the strings of zero copy sends the kernel has completed.
+void NetLinkWrapper::release_zero_copy_strings()
+{
+    if (this->zero_copy_strings.empty())
+    {
+        return;
+    }
+
+    auto completed = this->socket->zeroCopyCompleted();
+    while (!this->zero_copy_strings.empty() && this->zero_copy_strings.front().first <= completed)
+    {
+        this->zero_copy_strings.pop_front();
+    }
+}
+
 void NetLinkWrapper::init(v8::Local<v8::Object> exports)
 {
     auto isolate = v8::Isolate::GetCurrent();
@@ -125,17 +292,79 @@ void NetLinkWrapper::init(v8::Local<v8::Object> exports)
     auto tcp_client_instance_template = tcp_client_template->InstanceTemplate();
     tcp_client_instance_template->SetInternalFieldCount(1);
 
+    tcp_client_instance_template->SetAccessor(
+        v8_str("bufferPool"),
+        getter_buffer_pool,
+        setter_buffer_pool);
     tcp_client_instance_template->SetAccessor(
         v8_str("hostTo"),
         getter_host_to,
         setter_throw_exception);
+    tcp_client_instance_template->SetAccessor(
+        v8_str("isCorked"),
+        getter_is_corked,
+        setter_throw_exception);
     tcp_client_instance_template->SetAccessor(
         v8_str("portTo"),
         getter_port_to,
         setter_throw_exception);
+    tcp_client_instance_template->SetAccessor(
+        v8_str("readAhead"),
+        getter_read_ahead,
+        setter_read_ahead);
+    tcp_client_instance_template->SetAccessor(
+        v8_str("readAheadBytesServed"),
+        getter_read_ahead_bytes_served,
+        setter_throw_exception);
+    tcp_client_instance_template->SetAccessor(
+        v8_str("readAheadRefills"),
+        getter_read_ahead_refills,
+        setter_throw_exception);
+    tcp_client_instance_template->SetAccessor(
+        v8_str("writeQueue"),
+        getter_write_queue,
+        setter_write_queue);
+    tcp_client_instance_template->SetAccessor(
+        v8_str("writeQueueSize"),
+        getter_write_queue_size,
+        setter_throw_exception);
+    tcp_client_instance_template->SetAccessor(
+        v8_str("zeroCopy"),
+        getter_zero_copy,
+        setter_zero_copy);
+    tcp_client_instance_template->SetAccessor(
+        v8_str("zeroCopyCompleted"),
+        getter_zero_copy_completed,
+        setter_throw_exception);
+    tcp_client_instance_template->SetAccessor(
+        v8_str("zeroCopyCopied"),
+        getter_zero_copy_copied,
+        setter_throw_exception);
+    tcp_client_instance_template->SetAccessor(
+        v8_str("zeroCopySent"),
+        getter_zero_copy_sent,
+        setter_throw_exception);
+    tcp_client_instance_template->SetAccessor(
+        v8_str("zeroCopyThreshold"),
+        getter_zero_copy_threshold,
+        setter_zero_copy_threshold);
 
+    tcp_client_template->Set(
+        v8_str("connect"),
+        v8::FunctionTemplate::New(isolate, connect_tcp_client));
+
+    NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "cork", cork);
+    NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "flush", flush);
     NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "receive", receive);
+    NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "receiveInto", receive_into);
+    NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "receiveLines", receive_lines);
+    NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "receiveMessages", receive_messages);
+    NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "receiveString", receive_string);
+    NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "receiveUntil", receive_until);
     NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "send", send);
+    NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "sendFile", send_file);
+    NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "setFraming", set_framing);
+    NODE_SET_PROTOTYPE_METHOD(tcp_client_template, "uncork", uncork);
 
     /* -- TCP Server -- */
     auto name_tcp_server = v8_str("SocketServerTCP");
@@ -161,13 +390,66 @@ void NetLinkWrapper::init(v8::Local<v8::Object> exports)
     auto udp_instance_template = udp_template->InstanceTemplate();
     udp_instance_template->SetInternalFieldCount(1);
 
+    udp_instance_template->SetAccessor(
+        v8_str("addressCacheHits"),
+        getter_address_cache_hits,
+        setter_throw_exception);
+
+    udp_instance_template->SetAccessor(
+        v8_str("addressCacheMisses"),
+        getter_address_cache_misses,
+        setter_throw_exception);
+
+    udp_instance_template->SetAccessor(
+        v8_str("addressCacheSize"),
+        getter_address_cache_size,
+        setter_address_cache_size);
+
+    udp_instance_template->SetAccessor(
+        v8_str("bufferPool"),
+        getter_buffer_pool,
+        setter_buffer_pool);
+
+    udp_instance_template->SetAccessor(
+        v8_str("gro"),
+        getter_gro,
+        setter_gro);
+
+    udp_instance_template->SetAccessor(
+        v8_str("maxDatagramSize"),
+        getter_max_datagram_size,
+        setter_max_datagram_size);
+
     udp_instance_template->SetAccessor(
         v8_str("hostFrom"),
         getter_host_from,
         setter_throw_exception);
 
+    udp_instance_template->SetAccessor(
+        v8_str("hostTo"),
+        getter_host_to,
+        setter_throw_exception);
+
+    udp_instance_template->SetAccessor(
+        v8_str("isConnected"),
+        getter_is_connected,
+        setter_throw_exception);
+
+    udp_instance_template->SetAccessor(
+        v8_str("portTo"),
+        getter_port_to,
+        setter_throw_exception);
+
+    NODE_SET_PROTOTYPE_METHOD(udp_template, "connect", connect);
+    NODE_SET_PROTOTYPE_METHOD(udp_template, "receive", receive_datagram);
     NODE_SET_PROTOTYPE_METHOD(udp_template, "receiveFrom", receive_from);
+    NODE_SET_PROTOTYPE_METHOD(udp_template, "receiveFromInto", receive_from_into);
+    NODE_SET_PROTOTYPE_METHOD(udp_template, "receiveFromMany", receive_from_many);
+    NODE_SET_PROTOTYPE_METHOD(udp_template, "receiveFromRaw", receive_from_raw);
+    NODE_SET_PROTOTYPE_METHOD(udp_template, "send", send);
     NODE_SET_PROTOTYPE_METHOD(udp_template, "sendTo", send_to);
+    NODE_SET_PROTOTYPE_METHOD(udp_template, "sendToMany", send_to_many);
+    NODE_SET_PROTOTYPE_METHOD(udp_template, "sendToSegmented", send_to_segmented);
 
     // Actually expose them to our module's exports
     Nan::Set(exports, name_base, Nan::GetFunction(base_template).ToLocalChecked());
@@ -202,11 +484,15 @@ void NetLinkWrapper::new_tcp_client(const v8::FunctionCallbackInfo<v8::Value> &a
     std::string host;
     std::uint16_t port = 0;
     NL::IPVer ip_version = NL::IPVer::IP4;
+    std::uint32_t connect_timeout = 0;
+    std::uint32_t connect_stagger = DEFAULT_CONNECT_STAGGER;
 
     if (ArgParser(args)
             .arg("port", port)
             .arg("host", host)
-            .opt("ipVersion", ip_version)
+            .opt("ipVersion", ip_version, GetValue::SubType::AnyIPVersion)
+            .opt("connectTimeout", connect_timeout)
+            .opt("connectStagger", connect_stagger)
             .isInvalid())
     {
         return;
@@ -215,7 +501,7 @@ void NetLinkWrapper::new_tcp_client(const v8::FunctionCallbackInfo<v8::Value> &a
     NL::Socket *socket;
     try
     {
-        socket = new NL::Socket(host, port, NL::Protocol::TCP, ip_version);
+        socket = new NL::Socket(host, port, NL::Protocol::TCP, ip_version, connect_timeout, connect_stagger);
     }
     catch (NL::Exception &err)
     {
@@ -242,11 +528,13 @@ void NetLinkWrapper::new_udp(const v8::FunctionCallbackInfo<v8::Value> &args)
     std::uint16_t port_from = 0;
     std::string host_from;
     NL::IPVer ip_version = NL::IPVer::IP4;
+    GetValue::HostPort connect_to;
 
     if (ArgParser(args)
             .opt("portFrom", port_from)
             .opt("hostFrom", host_from)
             .opt("ipVersion", ip_version)
+            .opt("connectTo", connect_to)
             .isInvalid())
     {
         return;
@@ -263,6 +551,20 @@ void NetLinkWrapper::new_udp(const v8::FunctionCallbackInfo<v8::Value> &args)
         return;
     }
 
+    if (args.Length() > 3 && !args[3]->IsUndefined())
+    {
+        try
+        {
+            socket->connect(connect_to.host, connect_to.port);
+        }
+        catch (NL::Exception &err)
+        {
+            delete socket;
+            throw_js_error(err);
+            return;
+        }
+    }
+
     NetLinkWrapper *obj = new NetLinkWrapper(socket);
     obj->Wrap(args.This());
     args.GetReturnValue().Set(args.This());
@@ -306,6 +608,47 @@ void NetLinkWrapper::new_tcp_server(const v8::FunctionCallbackInfo<v8::Value> &a
     args.GetReturnValue().Set(args.This());
 }
 
+/* -- JS static methods -- */
+
+void NetLinkWrapper::connect_tcp_client(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    std::string host;
+    std::uint16_t port = 0;
+    NL::IPVer ip_version = NL::IPVer::IP4;
+    std::uint32_t connect_timeout = DEFAULT_ASYNC_CONNECT_TIMEOUT;
+    std::uint32_t connect_stagger = DEFAULT_CONNECT_STAGGER;
+
+    if (ArgParser(args)
+            .arg("port", port)
+            .arg("host", host)
+            .opt("ipVersion", ip_version, GetValue::SubType::AnyIPVersion)
+            .opt("connectTimeout", connect_timeout)
+            .opt("connectStagger", connect_stagger)
+            .isInvalid())
+    {
+        return;
+    }
+
+    auto isolate = v8::Isolate::GetCurrent();
+    auto resolver = v8::Promise::Resolver::New(isolate->GetCurrentContext()).ToLocalChecked();
+
+    Nan::AsyncQueueWorker(new ConnectWorker(resolver, host, port, ip_version, connect_timeout, connect_stagger));
+
+    args.GetReturnValue().Set(resolver->GetPromise());
+}
+
+v8::Local<v8::Object> NetLinkWrapper::wrap_tcp_client(NL::Socket *socket)
+{
+    auto new_wrapper = new NetLinkWrapper(socket);
+    auto isolate = v8::Isolate::GetCurrent();
+    auto function_template = NetLinkWrapper::class_socket_tcp_client.Get(isolate);
+    auto object_template = function_template->InstanceTemplate();
+    auto instance = Nan::NewInstance(object_template).ToLocalChecked();
+    new_wrapper->Wrap(instance);
+
+    return instance;
+}
+
 /* -- JS methods -- */
 
 void NetLinkWrapper::accept(const v8::FunctionCallbackInfo<v8::Value> &args)
@@ -329,16 +672,78 @@ void NetLinkWrapper::accept(const v8::FunctionCallbackInfo<v8::Value> &args)
 
     if (accepted != NULL)
     {
-        auto new_wrapper = new NetLinkWrapper(accepted);
         // accept() only works on TCP servers,
         // So we know for certain wrapped instances always must be TCP clients
-        auto isolate = v8::Isolate::GetCurrent();
-        auto function_template = NetLinkWrapper::class_socket_tcp_client.Get(isolate);
-        auto object_template = function_template->InstanceTemplate();
-        auto instance = Nan::NewInstance(object_template).ToLocalChecked();
-        new_wrapper->Wrap(instance);
+        args.GetReturnValue().Set(wrap_tcp_client(accepted));
+    }
+}
+
+void NetLinkWrapper::connect(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    // either (endpoint) or (host, port)
+    Endpoint *endpoint = args.Length() > 0 ? Endpoint::from_value(args[0]) : nullptr;
+    std::string host;
+    std::uint16_t port = 0;
+    if (endpoint != nullptr)
+    {
+        if (ArgParser(args)
+                .arg("endpoint", endpoint)
+                .isInvalid())
+        {
+            return;
+        }
+    }
+    else if (ArgParser(args)
+                 .arg("host", host)
+                 .arg("port", port)
+                 .isInvalid())
+    {
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed() || (endpoint != nullptr && obj->throw_if_wrong_ip_version(endpoint)))
+    {
+        return;
+    }
+
+    try
+    {
+        if (endpoint != nullptr)
+        {
+            obj->socket->connect(endpoint->address);
+        }
+        else
+        {
+            obj->socket->connect(host, port);
+        }
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    obj->host_to = obj->socket->hostTo();
+    obj->port_to = obj->socket->portTo();
+}
+
+void NetLinkWrapper::cork(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
 
-        args.GetReturnValue().Set(instance);
+    try
+    {
+        obj->socket->cork(true);
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
     }
 }
 
@@ -357,13 +762,15 @@ void NetLinkWrapper::disconnect(const v8::FunctionCallbackInfo<v8::Value> &args)
         if (obj->socket->protocol() == NL::Protocol::TCP && obj->socket->type() == NL::SocketType::CLIENT)
         {
             auto size = obj->socket->nextReadSize();
-            if (size > 0)
+            while (size > 0)
             {
                 // we need to drain the socket. Otherwise it will hang on closing the
                 // socket if there is still data in the buffer.
+                // Loops as read-ahead data is served separately from the OS's.
                 char *buffer = new char[size + 1];
-                obj->socket->read(buffer, size);
+                auto read = obj->socket->read(buffer, size);
                 delete[] buffer;
+                size = read > 0 ? obj->socket->nextReadSize() : 0;
             }
         }
     }
@@ -387,7 +794,7 @@ void NetLinkWrapper::disconnect(const v8::FunctionCallbackInfo<v8::Value> &args)
     obj->socket = nullptr;
 }
 
-void NetLinkWrapper::receive(const v8::FunctionCallbackInfo<v8::Value> &args)
+void NetLinkWrapper::flush(const v8::FunctionCallbackInfo<v8::Value> &args)
 {
     auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
     if (obj->throw_if_destroyed())
@@ -395,12 +802,10 @@ void NetLinkWrapper::receive(const v8::FunctionCallbackInfo<v8::Value> &args)
         return;
     }
 
-    int next_read_size = 0;
-    bool blocking = false;
+    std::size_t queued = 0;
     try
     {
-        next_read_size = obj->socket->nextReadSize();
-        blocking = obj->socket->blocking();
+        queued = obj->socket->flush();
     }
     catch (NL::Exception &err)
     {
@@ -408,73 +813,64 @@ void NetLinkWrapper::receive(const v8::FunctionCallbackInfo<v8::Value> &args)
         return;
     }
 
-    if (next_read_size < 1 && !blocking)
-    {
-        // we're not blocking and there is nothing to read, returning here
-        // will return undefined to the js function, as there was nothing
-        // to read.
-        return;
-    }
+    args.GetReturnValue().Set(Nan::New(static_cast<double>(queued)));
+}
 
-    std::stringstream ss;
-    try
-    {
-        bool keep_reading = true;
-        while (keep_reading)
-        {
-            auto buffer = std::array<char, READ_SIZE>();
-            auto buffer_read = obj->socket->read(buffer.data(), READ_SIZE);
-            if (buffer_read > 0)
-            {
-                ss << std::string(buffer.data(), buffer_read);
-            }
-            if (buffer_read != READ_SIZE)
-            {
-                keep_reading = false;
-            }
-        }
-    }
-    catch (NL::Exception &err)
+void NetLinkWrapper::receive(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    std::uint32_t max_bytes = UINT32_MAX;
+    if (ArgParser(args)
+            .opt("maxBytes", max_bytes)
+            .isInvalid())
     {
-        throw_js_error(err);
         return;
     }
 
-    auto str = ss.str();
-    if (str.length()) // range check
+    if (max_bytes == 0)
     {
-        args.GetReturnValue().Set(Nan::CopyBuffer(str.c_str(), str.length()).ToLocalChecked());
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::RangeError(v8_str("Argument \"maxBytes\" must be greater than 0.")));
+        return;
     }
-    // else it did not read any data, so this will return undefined
-}
 
-void NetLinkWrapper::receive_from(const v8::FunctionCallbackInfo<v8::Value> &args)
-{
     auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
     if (obj->throw_if_destroyed())
     {
         return;
     }
 
-    std::stringstream read_ss;
-    std::string host_from = "";
-    unsigned int port_from = 0;
-    try
+    if (obj->frame_buffer != nullptr && obj->frame_buffer->size() > 0)
     {
-        bool keep_reading = true;
-        while (keep_reading)
+        // already have data buffered from a framed receive, hand that back
+        // first, followed by whatever the socket can give without waiting
+        std::vector<char> drained;
+        try
         {
-            auto buffer = std::array<char, READ_SIZE>();
-            auto buffer_read = obj->socket->readFrom(buffer.data(), READ_SIZE, &host_from, &port_from);
-            if (buffer_read > 0)
-            {
-                read_ss << std::string(buffer.data(), buffer_read);
-            }
-            if (buffer_read != READ_SIZE)
+            obj->read_into(drained, max_bytes);
+            if (drained.size() < max_bytes && obj->socket->nextReadSize() > 0)
             {
-                keep_reading = false;
+                obj->read_into(drained, max_bytes - drained.size());
             }
         }
+        catch (NL::Exception &err)
+        {
+            throw_js_error(err);
+            return;
+        }
+
+        auto buffer = obj->buffer_pool
+                          ? obj->buffer_pool->copy(drained.data(), drained.size())
+                          : Nan::CopyBuffer(drained.data(), drained.size()).ToLocalChecked();
+        args.GetReturnValue().Set(buffer);
+        return;
+    }
+
+    int next_read_size = 0;
+    bool blocking = false;
+    try
+    {
+        next_read_size = obj->socket->nextReadSize();
+        blocking = obj->socket->blocking();
     }
     catch (NL::Exception &err)
     {
@@ -482,126 +878,1687 @@ void NetLinkWrapper::receive_from(const v8::FunctionCallbackInfo<v8::Value> &arg
         return;
     }
 
-    auto read = read_ss.str();
-    if (host_from.length() || port_from || read.length())
+    if (next_read_size < 1 && !blocking)
     {
-        auto return_object = Nan::New<v8::Object>();
-
-        auto host_key = v8_str("host");
-        auto host_value = v8_str(host_from);
+        // we're not blocking and there is nothing to read, returning here
+        // will return undefined to the js function, as there was nothing
+        // to read.
+        return;
+    }
+
+    // Size the read from what the kernel says is queued (FIONREAD), so it
+    // normally takes a single recv. When blocking with nothing queued yet
+    // we fall back to READ_SIZE, and grow if more arrived in the meantime.
+    std::size_t capacity = next_read_size > 0 ? next_read_size : READ_SIZE;
+    capacity = std::min<std::size_t>(capacity, max_bytes);
+
+    auto pooled = obj->buffer_pool ? obj->buffer_pool->reserve(capacity) : nullptr;
+    if (pooled != nullptr)
+    {
+        // read straight into the pool's slab, anything that did not fit
+        // is left on the socket for the next call
+        int pooled_read = 0;
+        try
+        {
+            pooled_read = obj->socket->read(pooled, capacity);
+        }
+        catch (NL::Exception &err)
+        {
+            throw_js_error(err);
+            return;
+        }
+
+        if (pooled_read > 0)
+        {
+            args.GetReturnValue().Set(obj->buffer_pool->commit(pooled_read));
+        }
+        return;
+    }
+
+    std::size_t length = 0;
+    char *data = static_cast<char *>(malloc(capacity));
+    try
+    {
+        while (data != nullptr)
+        {
+            auto buffer_read = obj->socket->read(data + length, capacity - length);
+            if (buffer_read <= 0)
+            {
+                break;
+            }
+
+            length += buffer_read;
+            if (length < capacity || length >= max_bytes)
+            {
+                // short read means we drained the socket
+                break;
+            }
+
+            auto more = obj->socket->nextReadSize();
+            if (more < 1)
+            {
+                break;
+            }
+
+            capacity = std::min<std::size_t>(length + more, max_bytes);
+            auto grown = static_cast<char *>(realloc(data, capacity));
+            if (grown == nullptr)
+            {
+                break; // keep what we have, the rest is read next call
+            }
+            data = grown;
+        }
+    }
+    catch (NL::Exception &err)
+    {
+        free(data);
+        throw_js_error(err);
+        return;
+    }
+
+    if (data == nullptr)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Could not allocate memory to receive into.")));
+        return;
+    }
+
+    if (length == 0)
+    {
+        // it did not read any data, so this will return undefined
+        free(data);
+        return;
+    }
+
+    // The Buffer takes ownership of data, so it is not copied again.
+    args.GetReturnValue().Set(Nan::NewBuffer(data, length).ToLocalChecked());
+}
+
+void NetLinkWrapper::receive_datagram(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    if (!obj->socket->connected())
+    {
+        // it would drop the address of whoever sent it, which receiveFrom keeps
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Cannot receive on a SocketUDP that is not connected, use receiveFrom() instead.")));
+        return;
+    }
+
+    // As receiveFrom(), a datagram must be received whole. Once connected
+    // the kernel only queues the peer's, so there is no address to report.
+    if (obj->datagram_scratch.size() < obj->max_datagram_size)
+    {
+        obj->datagram_scratch.resize(obj->max_datagram_size);
+    }
+
+    auto data = obj->datagram_scratch.data();
+    struct sockaddr_storage address_from;
+    unsigned int segment_size = 0;
+    bool truncated = false;
+    auto gro = obj->socket->gro();
+    int read = 0;
+    try
+    {
+        read = obj->socket->readFrom(
+            data,
+            obj->max_datagram_size,
+            &address_from,
+            gro ? &segment_size : nullptr,
+            &truncated);
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    if (read >= 0 && address_from.ss_family != AF_UNSPEC)
+    {
+        auto return_object = Nan::New<v8::Object>();
+        Nan::Set(
+            return_object,
+            v8_str("data"),
+            obj->buffer_pool
+                ? obj->buffer_pool->copy(data, read)
+                : Nan::CopyBuffer(data, read).ToLocalChecked());
+        Nan::Set(return_object, v8_str("truncated"), Nan::New(truncated));
+        if (gro)
+        {
+            Nan::Set(return_object, v8_str("segmentSize"), Nan::New(segment_size));
+        }
+        args.GetReturnValue().Set(return_object);
+    }
+    // else it did not read any data, so this will return undefined
+}
+
+void NetLinkWrapper::receive_from(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    auto encoding = StringDecode::Encoding::Utf8;
+    auto as_string = args.Length() > 0 && !args[0]->IsUndefined();
+    if (ArgParser(args)
+            .opt("encoding", encoding)
+            .isInvalid())
+    {
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    // Each recvfrom consumes a whole datagram, so it must be received in one
+    // go into memory big enough for any datagram we accept.
+    if (obj->datagram_scratch.size() < obj->max_datagram_size)
+    {
+        obj->datagram_scratch.resize(obj->max_datagram_size);
+    }
+
+    auto data = obj->datagram_scratch.data();
+    struct sockaddr_storage address_from;
+    unsigned int segment_size = 0;
+    bool truncated = false;
+    auto gro = obj->socket->gro();
+    int read = 0;
+    try
+    {
+        read = obj->socket->readFrom(
+            data,
+            obj->max_datagram_size,
+            &address_from,
+            gro ? &segment_size : nullptr,
+            &truncated);
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    if (read >= 0 && address_from.ss_family != AF_UNSPEC)
+    {
+        auto return_object = Nan::New<v8::Object>();
+
+        auto host_key = v8_str("host");
+        auto host_value = obj->address_cache.host(address_from);
         Nan::Set(return_object, host_key, host_value);
 
         auto port_key = v8_str("port");
-        auto port_value = Nan::New(port_from);
+        auto port_value = Nan::New(NL::Socket::portFromAddress(address_from));
         Nan::Set(return_object, port_key, port_value);
 
         auto data_key = v8_str("data");
-        auto data_value = Nan::CopyBuffer(read.c_str(), read.length()).ToLocalChecked();
+        v8::Local<v8::Value> data_value;
+        if (as_string)
+        {
+            // datagrams are whole, so there are never partial characters
+            // to carry over to the next one
+            data_value = StringDecode::decode(data, read, encoding).ToLocalChecked();
+        }
+        else
+        {
+            data_value = obj->buffer_pool
+                             ? obj->buffer_pool->copy(data, read)
+                             : Nan::CopyBuffer(data, read).ToLocalChecked();
+        }
         Nan::Set(return_object, data_key, data_value);
 
+        Nan::Set(return_object, v8_str("truncated"), Nan::New(truncated));
+        if (gro)
+        {
+            Nan::Set(return_object, v8_str("segmentSize"), Nan::New(segment_size));
+        }
+
         args.GetReturnValue().Set(return_object);
     }
     // else it did not read any data, so this will return undefined
 }
 
-void NetLinkWrapper::set_blocking(const v8::FunctionCallbackInfo<v8::Value> &args)
+void NetLinkWrapper::receive_into(const v8::FunctionCallbackInfo<v8::Value> &args)
 {
-    bool blocking = true;
+    GetValue::BufferView view;
+    std::uint32_t offset = 0;
+    std::uint32_t length = 0;
     if (ArgParser(args)
-            .arg("blocking", blocking)
+            .arg("buffer", view)
+            .opt("offset", offset)
+            .opt("length", length)
+            .isInvalid())
+    {
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    auto has_length = args.Length() > 2 && !args[2]->IsUndefined();
+    if (!narrow_buffer_view(view, offset, length, has_length))
+    {
+        return;
+    }
+
+    auto taken = obj->take_frame_buffer(view.data, view.length);
+    if (taken > 0)
+    {
+        args.GetReturnValue().Set(Nan::New(static_cast<std::uint32_t>(taken)));
+        return;
+    }
+
+    int next_read_size = 0;
+    bool blocking = false;
+    int read = 0;
+    try
+    {
+        next_read_size = obj->socket->nextReadSize();
+        blocking = obj->socket->blocking();
+
+        if (next_read_size < 1 && !blocking)
+        {
+            // nothing to read and we can't wait for it, return undefined
+            return;
+        }
+
+        // recv straight into the caller's memory, no intermediate copies
+        read = obj->socket->read(view.data, view.length);
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    if (read > 0)
+    {
+        args.GetReturnValue().Set(Nan::New(read));
+    }
+    // else it did not read any data, so this will return undefined
+}
+
+void NetLinkWrapper::receive_from_into(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    GetValue::BufferView view;
+    std::uint32_t offset = 0;
+    std::uint32_t length = 0;
+    if (ArgParser(args)
+            .arg("buffer", view)
+            .opt("offset", offset)
+            .opt("length", length)
+            .isInvalid())
+    {
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    auto has_length = args.Length() > 2 && !args[2]->IsUndefined();
+    if (!narrow_buffer_view(view, offset, length, has_length))
+    {
+        return;
+    }
+
+    struct sockaddr_storage address_from;
+    unsigned int segment_size = 0;
+    bool truncated = false;
+    auto gro = obj->socket->gro();
+    int read = 0;
+    try
+    {
+        read = obj->socket->readFrom(view.data, view.length, &address_from, gro ? &segment_size : nullptr, &truncated);
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    if (read >= 0 && address_from.ss_family != AF_UNSPEC)
+    {
+        auto return_object = Nan::New<v8::Object>();
+
+        Nan::Set(return_object, v8_str("host"), obj->address_cache.host(address_from));
+        Nan::Set(return_object, v8_str("port"), Nan::New(NL::Socket::portFromAddress(address_from)));
+        Nan::Set(return_object, v8_str("bytesRead"), Nan::New(read));
+        Nan::Set(return_object, v8_str("truncated"), Nan::New(truncated));
+        if (gro)
+        {
+            Nan::Set(return_object, v8_str("segmentSize"), Nan::New(segment_size));
+        }
+
+        args.GetReturnValue().Set(return_object);
+    }
+    // else it did not read any data, so this will return undefined
+}
+
+void NetLinkWrapper::receive_from_many(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    std::uint32_t max_datagrams = 0;
+    std::uint32_t buffer_size = 0;
+    if (ArgParser(args)
+            .arg("maxDatagrams", max_datagrams)
+            .arg("bufferSize", buffer_size)
             .isInvalid())
     {
         return;
     }
 
-    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
-    if (obj->throw_if_destroyed())
+    auto isolate = v8::Isolate::GetCurrent();
+    if (max_datagrams == 0)
+    {
+        isolate->ThrowException(v8::Exception::RangeError(v8_str("Argument \"maxDatagrams\" must be greater than 0.")));
+        return;
+    }
+    if (buffer_size == 0)
+    {
+        isolate->ThrowException(v8::Exception::RangeError(v8_str("Argument \"bufferSize\" must be greater than 0.")));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    // Every datagram is received into its own bufferSize slot, then packed
+    // back to back so the returned Buffer holds no gaps.
+    auto capacity = static_cast<std::size_t>(max_datagrams) * buffer_size;
+    auto pooled = obj->buffer_pool ? obj->buffer_pool->reserve(capacity) : nullptr;
+    auto data = pooled != nullptr ? pooled : static_cast<char *>(malloc(capacity));
+    if (data == nullptr)
+    {
+        isolate->ThrowException(v8::Exception::Error(v8_str("Could not allocate memory to receive into.")));
+        return;
+    }
+
+    auto lengths = std::vector<std::size_t>(max_datagrams);
+    auto addresses = std::vector<struct sockaddr_storage>(max_datagrams);
+    // GRO coalesced datagrams keep their boundaries only by their segment size
+    auto gro = obj->socket->gro();
+    auto segment_sizes = std::vector<unsigned int>(gro ? max_datagrams : 0);
+    int received = 0;
+    try
+    {
+        received = obj->socket->readFromMany(
+            data,
+            buffer_size,
+            max_datagrams,
+            lengths.data(),
+            addresses.data(),
+            gro ? segment_sizes.data() : nullptr);
+    }
+    catch (NL::Exception &err)
+    {
+        if (pooled == nullptr)
+        {
+            free(data);
+        }
+        throw_js_error(err);
+        return;
+    }
+
+    if (received < 1)
+    {
+        // it did not read any data, so this will return undefined
+        if (pooled == nullptr)
+        {
+            free(data);
+        }
+        return;
+    }
+
+    auto count = static_cast<std::size_t>(received);
+    auto offsets_buffer = v8::ArrayBuffer::New(isolate, (count + 1) * sizeof(std::int32_t));
+    auto offsets = v8::Int32Array::New(offsets_buffer, 0, count + 1);
+    Nan::TypedArrayContents<std::int32_t> offsets_contents(offsets);
+    auto lengths_buffer = v8::ArrayBuffer::New(isolate, count * sizeof(std::int32_t));
+    auto lengths_array = v8::Int32Array::New(lengths_buffer, 0, count);
+    Nan::TypedArrayContents<std::int32_t> lengths_contents(lengths_array);
+    auto ports_buffer = v8::ArrayBuffer::New(isolate, count * sizeof(std::uint16_t));
+    auto ports = v8::Uint16Array::New(ports_buffer, 0, count);
+    Nan::TypedArrayContents<std::uint16_t> ports_contents(ports);
+    auto indices_buffer = v8::ArrayBuffer::New(isolate, count * sizeof(std::uint32_t));
+    auto address_indices = v8::Uint32Array::New(indices_buffer, 0, count);
+    Nan::TypedArrayContents<std::uint32_t> indices_contents(address_indices);
+
+    // senders are usually few, so each distinct host appears once
+    auto hosts = Nan::New<v8::Array>();
+    std::unordered_map<AddressCache::Key, std::uint32_t, AddressCache::KeyHash> host_indices;
+
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        memmove(data + position, data + i * buffer_size, lengths[i]);
+        (*offsets_contents)[i] = static_cast<std::int32_t>(position);
+        (*lengths_contents)[i] = static_cast<std::int32_t>(lengths[i]);
+        position += lengths[i];
+
+        auto &address = addresses[i];
+        (*ports_contents)[i] = static_cast<std::uint16_t>(NL::Socket::portFromAddress(address));
+
+        auto key = AddressCache::key_of(address);
+        auto found = host_indices.find(key);
+        if (found == host_indices.end())
+        {
+            auto index = static_cast<std::uint32_t>(host_indices.size());
+            found = host_indices.emplace(key, index).first;
+            Nan::Set(hosts, index, obj->address_cache.host(address));
+        }
+        (*indices_contents)[i] = found->second;
+    }
+    (*offsets_contents)[count] = static_cast<std::int32_t>(position);
+
+    v8::Local<v8::Object> buffer;
+    if (pooled != nullptr)
+    {
+        buffer = obj->buffer_pool->commit(position);
+    }
+    else
+    {
+        // give back the unused slots, the Buffer takes ownership of data
+        auto shrunk = static_cast<char *>(realloc(data, std::max<std::size_t>(position, 1)));
+        buffer = Nan::NewBuffer(shrunk != nullptr ? shrunk : data, position).ToLocalChecked();
+    }
+
+    auto return_object = Nan::New<v8::Object>();
+    Nan::Set(return_object, v8_str("data"), buffer);
+    Nan::Set(return_object, v8_str("offsets"), offsets);
+    Nan::Set(return_object, v8_str("lengths"), lengths_array);
+    Nan::Set(return_object, v8_str("ports"), ports);
+    Nan::Set(return_object, v8_str("addressIndices"), address_indices);
+    Nan::Set(return_object, v8_str("addresses"), hosts);
+    if (gro)
+    {
+        auto segment_sizes_buffer = v8::ArrayBuffer::New(isolate, count * sizeof(std::int32_t));
+        auto segment_sizes_array = v8::Int32Array::New(segment_sizes_buffer, 0, count);
+        Nan::TypedArrayContents<std::int32_t> segment_sizes_contents(segment_sizes_array);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            (*segment_sizes_contents)[i] = static_cast<std::int32_t>(segment_sizes[i]);
+        }
+        Nan::Set(return_object, v8_str("segmentSizes"), segment_sizes_array);
+    }
+    args.GetReturnValue().Set(return_object);
+}
+
+void NetLinkWrapper::receive_from_raw(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    GetValue::BufferView view;
+    v8::Local<v8::Uint32Array> info;
+    if (ArgParser(args)
+            .arg("buffer", view)
+            .arg("info", info)
+            .isInvalid())
+    {
+        return;
+    }
+
+    Nan::TypedArrayContents<std::uint32_t> info_contents(info);
+    if (info_contents.length() < RAW_INFO_LENGTH)
+    {
+        std::stringstream ss;
+        ss << "Argument \"info\" must have a length of at least "
+           << RAW_INFO_LENGTH << ".";
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::RangeError(v8_str(ss.str())));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    if (obj->socket->gro())
+    {
+        // info has no room for a segment size, without which the boundaries
+        // of GRO coalesced datagrams would be lost
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Cannot receiveFromRaw with gro enabled, use receiveFromInto() instead.")));
+        return;
+    }
+
+    struct sockaddr_storage address_from;
+    bool truncated = false;
+    int read = 0;
+    try
+    {
+        read = obj->socket->readFrom(view.data, view.length, &address_from, nullptr, &truncated);
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    if (read < 0 || address_from.ss_family == AF_UNSPEC)
+    {
+        // nothing to receive
+        args.GetReturnValue().Set(Nan::New(-1));
+        return;
+    }
+
+    // Layout: port, IP version (4 or 6), truncated (0 or 1), then the address
+    // as 4 big endian words. IPv4 addresses are a single numeric word.
+    auto out = *info_contents;
+    out[0] = NL::Socket::portFromAddress(address_from);
+    out[2] = truncated ? 1 : 0;
+    out[3] = out[4] = out[5] = out[6] = 0;
+    if (address_from.ss_family == AF_INET)
+    {
+        auto in = reinterpret_cast<const struct sockaddr_in *>(&address_from);
+        out[1] = 4;
+        out[3] = ntohl(in->sin_addr.s_addr);
+    }
+    else
+    {
+        auto in6 = reinterpret_cast<const struct sockaddr_in6 *>(&address_from);
+        out[1] = 6;
+        for (int i = 0; i < 4; i++)
+        {
+            std::uint32_t word;
+            memcpy(&word, in6->sin6_addr.s6_addr + i * 4, sizeof(word));
+            out[3 + i] = ntohl(word);
+        }
+    }
+
+    args.GetReturnValue().Set(Nan::New(read));
+}
+
+void NetLinkWrapper::receive_messages(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    std::uint32_t max_messages = UINT32_MAX;
+    bool compact = false;
+    if (ArgParser(args)
+            .opt("maxMessages", max_messages)
+            .opt("compact", compact)
+            .isInvalid())
+    {
+        return;
+    }
+
+    if (max_messages == 0)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::RangeError(v8_str("Argument \"maxMessages\" must be greater than 0.")));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    if (obj->frame_prefix == Framing::Prefix::None)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Cannot receiveMessages without first calling setFraming().")));
+        return;
+    }
+
+    // (payload offset, payload length) of each complete frame found
+    std::vector<std::pair<std::size_t, std::size_t>> frames;
+    std::size_t consumed = 0;
+    std::size_t total_length = 0;
+    bool malformed = false;
+
+    auto parse_frames = [&]() {
+        auto data = static_cast<const unsigned char *>(obj->frame_buffer->buffer());
+        auto size = obj->frame_buffer->size();
+        while (frames.size() < max_messages)
+        {
+            std::size_t header_length = 0;
+            std::uint64_t frame_length = 0;
+            auto status = Framing::read_header(
+                obj->frame_prefix,
+                data + consumed,
+                size - consumed,
+                header_length,
+                frame_length);
+
+            if (status == Framing::HeaderStatus::Malformed || frame_length > obj->max_frame_length)
+            {
+                malformed = true;
+                return;
+            }
+
+            if (status == Framing::HeaderStatus::Incomplete || size - consumed - header_length < frame_length)
+            {
+                return; // the rest stays buffered until more arrives
+            }
+
+            frames.emplace_back(consumed + header_length, frame_length);
+            consumed += header_length + frame_length;
+            total_length += frame_length;
+        }
+    };
+
+    try
+    {
+        // pull in everything already queued, then block for at least one
+        // frame if need be
+        obj->fill_frame_buffer(false);
+        parse_frames();
+
+        while (frames.empty() && !malformed && obj->fill_frame_buffer(true))
+        {
+            parse_frames();
+        }
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    if (malformed)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Received a malformed frame length prefix, or one beyond the max frame length.")));
+        return;
+    }
+
+    if (frames.empty())
+    {
+        // no complete frames, so this will return undefined
+        return;
+    }
+
+    auto isolate = v8::Isolate::GetCurrent();
+    auto data = static_cast<const char *>(obj->frame_buffer->buffer());
+
+    if (compact)
+    {
+        // one Buffer of every payload back to back, and where each starts
+        auto offsets_buffer = v8::ArrayBuffer::New(isolate, (frames.size() + 1) * sizeof(std::int32_t));
+        auto offsets = v8::Int32Array::New(offsets_buffer, 0, frames.size() + 1);
+        Nan::TypedArrayContents<std::int32_t> offsets_contents(offsets);
+
+        // carved from the pool when there is one and the payloads fit a slab
+        auto joined = obj->buffer_pool ? obj->buffer_pool->reserve(total_length) : nullptr;
+        auto pooled = joined != nullptr;
+        if (!pooled)
+        {
+            joined = static_cast<char *>(malloc(std::max<std::size_t>(total_length, 1)));
+        }
+        if (joined == nullptr)
+        {
+            isolate->ThrowException(v8::Exception::Error(v8_str("Could not allocate memory to receive into.")));
+            return;
+        }
+
+        std::size_t position = 0;
+        for (std::size_t i = 0; i < frames.size(); i++)
+        {
+            (*offsets_contents)[i] = static_cast<std::int32_t>(position);
+            memcpy(joined + position, data + frames[i].first, frames[i].second);
+            position += frames[i].second;
+        }
+        (*offsets_contents)[frames.size()] = static_cast<std::int32_t>(position);
+
+        auto return_object = Nan::New<v8::Object>();
+        auto joined_buffer = pooled
+                                 ? obj->buffer_pool->commit(total_length)
+                                 : Nan::NewBuffer(joined, total_length).ToLocalChecked();
+        Nan::Set(return_object, v8_str("data"), joined_buffer);
+        Nan::Set(return_object, v8_str("offsets"), offsets);
+        args.GetReturnValue().Set(return_object);
+    }
+    else
+    {
+        auto messages = Nan::New<v8::Array>(static_cast<int>(frames.size()));
+        for (std::size_t i = 0; i < frames.size(); i++)
+        {
+            auto frame_data = data + frames[i].first;
+            auto frame_length = frames[i].second;
+            auto buffer = obj->buffer_pool
+                              ? obj->buffer_pool->copy(frame_data, frame_length)
+                              : Nan::CopyBuffer(frame_data, frame_length).ToLocalChecked();
+            Nan::Set(messages, static_cast<std::uint32_t>(i), buffer);
+        }
+        args.GetReturnValue().Set(messages);
+    }
+
+    obj->frame_buffer->erase(consumed);
+}
+
+void NetLinkWrapper::receive_string(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    auto encoding = StringDecode::Encoding::Utf8;
+    std::uint32_t max_bytes = UINT32_MAX;
+    if (ArgParser(args)
+            .opt("encoding", encoding)
+            .opt("maxBytes", max_bytes)
+            .isInvalid())
+    {
+        return;
+    }
+
+    auto isolate = v8::Isolate::GetCurrent();
+    if (max_bytes == 0)
+    {
+        isolate->ThrowException(v8::Exception::RangeError(v8_str("Argument \"maxBytes\" must be greater than 0.")));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    auto &pending = obj->string_pending;
+    std::size_t complete = 0;
+    try
+    {
+        while (obj->read_into(pending, max_bytes))
+        {
+            complete = encoding == StringDecode::Encoding::Utf8
+                           ? StringDecode::utf8_complete_length(pending.data(), pending.size())
+                           : pending.size();
+            if (complete > 0)
+            {
+                break;
+            }
+            // only part of a single character so far, wait for the rest
+        }
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    if (complete == 0)
+    {
+        // nothing to decode yet, so this will return undefined
+        return;
+    }
+
+    v8::Local<v8::String> str;
+    if (!StringDecode::decode(pending.data(), complete, encoding).ToLocal(&str))
+    {
+        isolate->ThrowException(v8::Exception::Error(v8_str("Received data is too long for a string.")));
+        return;
+    }
+
+    // keep any cut short character for next time
+    pending.erase(pending.begin(), pending.begin() + complete);
+    args.GetReturnValue().Set(str);
+}
+
+void NetLinkWrapper::receive_until(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    std::string delimiter;
+    std::uint32_t max_bytes = UINT32_MAX;
+    if (ArgParser(args)
+            .arg("delimiter", delimiter, GetValue::SubType::SendableData)
+            .opt("maxBytes", max_bytes)
+            .isInvalid())
+    {
+        return;
+    }
+
+    if (delimiter.length() == 0)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::RangeError(v8_str("Argument \"delimiter\" must not be empty.")));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    const char *found = nullptr;
+    std::size_t scanned = 0;
+    auto scan = [&]() {
+        auto data = static_cast<const char *>(obj->frame_buffer->buffer());
+        auto size = std::min<std::size_t>(obj->frame_buffer->size(), max_bytes + delimiter.length());
+        // resume where the last scan stopped, less a partial delimiter that
+        // may straddle the previous chunk boundary
+        auto from = scanned > delimiter.length() ? scanned - delimiter.length() + 1 : 0;
+        found = ByteScan::find_delimiter(data + from, size - from, delimiter.c_str(), delimiter.length());
+        scanned = size;
+    };
+
+    try
+    {
+        obj->fill_frame_buffer(false);
+        scan();
+
+        while (found == nullptr && scanned < max_bytes + delimiter.length() && obj->fill_frame_buffer(true))
+        {
+            scan();
+        }
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    if (found == nullptr)
+    {
+        if (obj->frame_buffer->size() >= max_bytes + delimiter.length())
+        {
+            auto isolate = v8::Isolate::GetCurrent();
+            isolate->ThrowException(v8::Exception::Error(v8_str("Delimiter not found within maxBytes.")));
+        }
+        // else not found yet, so this will return undefined
+        return;
+    }
+
+    auto data = static_cast<const char *>(obj->frame_buffer->buffer());
+    auto length = static_cast<std::size_t>(found - data);
+    auto buffer = obj->buffer_pool
+                      ? obj->buffer_pool->copy(data, length)
+                      : Nan::CopyBuffer(data, length).ToLocalChecked();
+    obj->frame_buffer->erase(length + delimiter.length());
+    args.GetReturnValue().Set(buffer);
+}
+
+void NetLinkWrapper::receive_lines(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    std::uint32_t max_lines = UINT32_MAX;
+    std::uint32_t max_bytes = UINT32_MAX;
+    if (ArgParser(args)
+            .opt("maxLines", max_lines)
+            .opt("maxBytes", max_bytes)
+            .isInvalid())
+    {
+        return;
+    }
+
+    if (max_lines == 0)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::RangeError(v8_str("Argument \"maxLines\" must be greater than 0.")));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    // (offset, length) of each line found, without its terminator
+    std::vector<std::pair<std::size_t, std::size_t>> lines;
+    std::size_t consumed = 0;
+    std::size_t scanned = 0;
+    auto scan = [&]() {
+        auto data = static_cast<const char *>(obj->frame_buffer->buffer());
+        while (lines.size() < max_lines)
+        {
+            auto size = std::min<std::size_t>(obj->frame_buffer->size(), consumed + max_bytes + 1);
+            // resume where the last scan of this line stopped
+            auto from = std::max(consumed, scanned);
+            auto newline = ByteScan::find_byte(data + from, size - from, '\n');
+            if (newline == nullptr)
+            {
+                scanned = size;
+                return;
+            }
+
+            auto end = static_cast<std::size_t>(newline - data);
+            auto length = end - consumed;
+            if (length > 0 && data[end - 1] == '\r')
+            {
+                length -= 1; // CRLF terminated
+            }
+
+            lines.emplace_back(consumed, length);
+            consumed = end + 1;
+        }
+    };
+
+    try
+    {
+        obj->fill_frame_buffer(false);
+        scan();
+
+        while (lines.empty() && scanned < max_bytes + 1 && obj->fill_frame_buffer(true))
+        {
+            scan();
+        }
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    if (lines.empty())
+    {
+        if (obj->frame_buffer->size() >= max_bytes + 1)
+        {
+            auto isolate = v8::Isolate::GetCurrent();
+            isolate->ThrowException(v8::Exception::Error(v8_str("Delimiter not found within maxBytes.")));
+        }
+        // else no complete lines, so this will return undefined
+        return;
+    }
+
+    auto data = static_cast<const char *>(obj->frame_buffer->buffer());
+    auto result = Nan::New<v8::Array>(static_cast<int>(lines.size()));
+    for (std::size_t i = 0; i < lines.size(); i++)
+    {
+        auto line_data = data + lines[i].first;
+        auto line_length = lines[i].second;
+        auto line = Nan::New(line_data, static_cast<int>(line_length)).ToLocalChecked();
+        Nan::Set(result, static_cast<std::uint32_t>(i), line);
+    }
+
+    obj->frame_buffer->erase(consumed);
+    args.GetReturnValue().Set(result);
+}
+
+void NetLinkWrapper::set_framing(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    Framing::Prefix prefix = Framing::Prefix::None;
+    std::uint32_t max_frame_length = DEFAULT_MAX_FRAME_LENGTH;
+    if (ArgParser(args)
+            .arg("prefix", prefix)
+            .opt("maxFrameLength", max_frame_length)
+            .isInvalid())
+    {
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    obj->frame_prefix = prefix;
+    obj->max_frame_length = max_frame_length;
+}
+
+void NetLinkWrapper::set_blocking(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    bool blocking = true;
+    if (ArgParser(args)
+            .arg("blocking", blocking)
+            .isInvalid())
+    {
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    try
+    {
+
+        obj->socket->blocking(blocking);
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+}
+
+void NetLinkWrapper::send(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    GetValue::reset_send_scratch();
+
+    std::vector<GetValue::SendableView> data;
+    GetValue::SendOptions options;
+    if (ArgParser(args)
+            .arg("data", data, GetValue::SubType::SendableData)
+            .opt("options", options)
+            .isInvalid())
+    {
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    std::size_t sent = 0;
+    try
+    {
+        if (data.size() == 1)
+        {
+            auto zero_copy_sent = obj->socket->zeroCopySent();
+            if (data[0].is_string && obj->socket->zeroCopy() && data[0].length() >= obj->socket->zeroCopyThreshold())
+            {
+                data[0].own(); // the send scratch is reused by the next send
+            }
+            sent = obj->socket->send(data[0].data(), data[0].length(), options.more);
+
+            if (data[0].is_string && obj->socket->zeroCopySent() != zero_copy_sent)
+            {
+                // the kernel still reads from it, JS memory is the caller's to keep
+                obj->zero_copy_strings.emplace_back(obj->socket->zeroCopySent(), std::move(data[0].encoded));
+            }
+        }
+        else
+        {
+            std::vector<const void *> buffers;
+            std::vector<std::size_t> sizes;
+            split_views(data, buffers, sizes);
+            sent = obj->socket->send(buffers.data(), sizes.data(), static_cast<unsigned>(data.size()), options.more);
+        }
+
+        obj->release_zero_copy_strings();
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    args.GetReturnValue().Set(Nan::New(static_cast<double>(sent)));
+}
+
+void NetLinkWrapper::send_file(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    GetValue::FileSource file;
+    std::uint64_t offset = 0;
+    std::uint64_t length = SIZE_MAX; // to the end of the file
+    if (ArgParser(args)
+            .arg("pathOrFd", file)
+            .opt("offset", offset)
+            .opt("length", length)
+            .isInvalid())
+    {
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    std::size_t sent = 0;
+    try
+    {
+        auto max_length = static_cast<std::size_t>(std::min<std::uint64_t>(length, SIZE_MAX));
+        if (file.fd == -1)
+        {
+            sent = obj->socket->sendFile(file.path, offset, max_length);
+        }
+        else
+        {
+            sent = obj->socket->sendFile(file.fd, offset, max_length);
+        }
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    args.GetReturnValue().Set(Nan::New(static_cast<double>(sent)));
+}
+
+void NetLinkWrapper::send_to(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    GetValue::reset_send_scratch();
+
+    // either (endpoint, data) or (host, port, data)
+    Endpoint *endpoint = args.Length() > 0 ? Endpoint::from_value(args[0]) : nullptr;
+    std::string host;
+    std::uint16_t port = 0;
+    std::vector<GetValue::SendableView> data;
+    if (endpoint != nullptr)
+    {
+        if (ArgParser(args)
+                .arg("endpoint", endpoint)
+                .arg("data", data, GetValue::SubType::SendableData)
+                .isInvalid())
+        {
+            return;
+        }
+    }
+    else if (ArgParser(args)
+                 .arg("host", host)
+                 .arg("port", port)
+                 .arg("data", data, GetValue::SubType::SendableData)
+                 .isInvalid())
+    {
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed() || (endpoint != nullptr && obj->throw_if_wrong_ip_version(endpoint)))
+    {
+        return;
+    }
+
+    try
+    {
+        struct sockaddr_storage resolved;
+        if (endpoint == nullptr)
+        {
+            obj->socket->resolveAddress(host, port, &resolved);
+        }
+        auto &address = endpoint != nullptr ? endpoint->address : resolved;
+
+        if (data.size() == 1)
+        {
+            obj->socket->sendTo(data[0].data(), data[0].length(), address);
+        }
+        else
+        {
+            std::vector<const void *> buffers;
+            std::vector<std::size_t> sizes;
+            split_views(data, buffers, sizes);
+            obj->socket->sendTo(buffers.data(), sizes.data(), static_cast<unsigned>(data.size()), address);
+        }
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+}
+
+void NetLinkWrapper::send_to_many(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    GetValue::reset_send_scratch();
+
+    auto isolate = v8::Isolate::GetCurrent();
+    auto context = isolate->GetCurrentContext();
+
+    // either (messages) of {host, port, data} or {endpoint, data}, or
+    // (host, port, payloads), or (endpoint, payloads)
+    auto single_destination = args.Length() > 1;
+    Endpoint *endpoint = single_destination ? Endpoint::from_value(args[0]) : nullptr;
+    std::string host;
+    std::uint16_t port = 0;
+    v8::Local<v8::Array> array;
+    if (endpoint != nullptr)
+    {
+        if (ArgParser(args)
+                .arg("endpoint", endpoint)
+                .arg("payloads", array)
+                .isInvalid())
+        {
+            return;
+        }
+    }
+    else if (single_destination)
+    {
+        if (ArgParser(args)
+                .arg("host", host)
+                .arg("port", port)
+                .arg("payloads", array)
+                .isInvalid())
+        {
+            return;
+        }
+    }
+    else if (ArgParser(args)
+                 .arg("messages", array)
+                 .isInvalid())
+    {
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed() || (endpoint != nullptr && obj->throw_if_wrong_ip_version(endpoint)))
+    {
+        return;
+    }
+
+    auto count = array->Length();
+    auto payloads = std::vector<GetValue::SendableView>(count);
+    auto destinations = std::vector<std::size_t>(count);
+    // Endpoints are used as is, so need no resolving
+    auto endpoints = std::vector<const Endpoint *>(count, endpoint);
+    std::vector<struct sockaddr_storage> addresses;
+    // each distinct host:port is resolved only once per call
+    std::unordered_map<std::string, std::size_t> address_indices;
+
+    auto invalid_element = [&](std::uint32_t index, const char *key, const std::string &reason) {
+        std::stringstream ss;
+        ss << "Element " << index << (key ? std::string(" \"") + key + "\"" : "")
+           << " of argument \"" << (single_destination ? "payloads" : "messages")
+           << "\" " << reason;
+        isolate->ThrowException(v8::Exception::TypeError(v8_str(ss.str())));
+    };
+
+    try
+    {
+        for (std::uint32_t i = 0; i < count; i++)
+        {
+            auto element = Nan::Get(array, i).ToLocalChecked();
+            auto data_value = element;
+            if (!single_destination)
+            {
+                if (!element->IsObject())
+                {
+                    invalid_element(i, nullptr, "must be an object. " + GetValue::get_typeof_str(element));
+                    return;
+                }
+
+                auto message = element->ToObject(context).ToLocalChecked();
+                auto endpoint_value = Nan::Get(message, v8_str("endpoint")).ToLocalChecked();
+                if (!endpoint_value->IsUndefined())
+                {
+                    Endpoint *message_endpoint = nullptr;
+                    auto error = GetValue::get_value(message_endpoint, endpoint_value, GetValue::SubType::None);
+                    if (error.length())
+                    {
+                        invalid_element(i, "endpoint", error);
+                        return;
+                    }
+                    if (obj->throw_if_wrong_ip_version(message_endpoint))
+                    {
+                        return;
+                    }
+                    endpoints[i] = message_endpoint;
+                }
+                else
+                {
+                    auto error = GetValue::get_value(host, Nan::Get(message, v8_str("host")).ToLocalChecked(), GetValue::SubType::None);
+                    if (error.length())
+                    {
+                        invalid_element(i, "host", error);
+                        return;
+                    }
+
+                    error = GetValue::get_value(port, Nan::Get(message, v8_str("port")).ToLocalChecked(), GetValue::SubType::None);
+                    if (error.length())
+                    {
+                        invalid_element(i, "port", error);
+                        return;
+                    }
+                }
+
+                data_value = Nan::Get(message, v8_str("data")).ToLocalChecked();
+            }
+
+            auto error = GetValue::get_value(payloads[i], data_value, GetValue::SubType::SendableData);
+            if (error.length())
+            {
+                invalid_element(i, single_destination ? nullptr : "data", error);
+                return;
+            }
+
+            if (endpoints[i] != nullptr)
+            {
+                continue;
+            }
+
+            std::stringstream key;
+            key << port << ' ' << host;
+            auto found = address_indices.find(key.str());
+            if (found == address_indices.end())
+            {
+                addresses.emplace_back();
+                obj->socket->resolveAddress(host, port, &addresses.back());
+                found = address_indices.emplace(key.str(), addresses.size() - 1).first;
+            }
+            destinations[i] = found->second;
+        }
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    // addresses no longer grows, so pointers into it are now stable
+    auto buffers = std::vector<const void *>(count);
+    auto sizes = std::vector<std::size_t>(count);
+    auto addresses_to = std::vector<const struct sockaddr_storage *>(count);
+    for (std::uint32_t i = 0; i < count; i++)
+    {
+        buffers[i] = payloads[i].data();
+        sizes[i] = payloads[i].length();
+        addresses_to[i] = endpoints[i] != nullptr ? &endpoints[i]->address : &addresses[destinations[i]];
+    }
+
+    int sent = 0;
+    try
+    {
+        sent = obj->socket->sendToMany(buffers.data(), sizes.data(), addresses_to.data(), count);
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+
+    args.GetReturnValue().Set(Nan::New(sent));
+}
+
+void NetLinkWrapper::send_to_segmented(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    GetValue::reset_send_scratch();
+
+    // either (endpoint, data, segmentSize) or (host, port, data, segmentSize)
+    Endpoint *endpoint = args.Length() > 0 ? Endpoint::from_value(args[0]) : nullptr;
+    std::string host;
+    std::uint16_t port = 0;
+    GetValue::SendableView data;
+    std::uint32_t segment_size = 0;
+    if (endpoint != nullptr)
+    {
+        if (ArgParser(args)
+                .arg("endpoint", endpoint)
+                .arg("data", data, GetValue::SubType::SendableData)
+                .arg("segmentSize", segment_size)
+                .isInvalid())
+        {
+            return;
+        }
+    }
+    else if (ArgParser(args)
+                 .arg("host", host)
+                 .arg("port", port)
+                 .arg("data", data, GetValue::SubType::SendableData)
+                 .arg("segmentSize", segment_size)
+                 .isInvalid())
+    {
+        return;
+    }
+
+    if (segment_size == 0)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::RangeError(v8_str("Argument \"segmentSize\" must be greater than 0.")));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed() || (endpoint != nullptr && obj->throw_if_wrong_ip_version(endpoint)))
+    {
+        return;
+    }
+
+    try
+    {
+        if (endpoint != nullptr)
+        {
+            obj->socket->sendToSegmented(data.data(), data.length(), endpoint->address, segment_size);
+        }
+        else
+        {
+            obj->socket->sendToSegmented(data.data(), data.length(), host, port, segment_size);
+        }
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+}
+
+void NetLinkWrapper::uncork(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    try
+    {
+        obj->socket->cork(false);
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+}
+
+/* -- Getters -- */
+
+void NetLinkWrapper::getter_address_cache_hits(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(obj->address_cache.hits)));
+};
+
+void NetLinkWrapper::getter_address_cache_misses(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(obj->address_cache.misses)));
+};
+
+void NetLinkWrapper::getter_address_cache_size(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(obj->address_cache.capacity())));
+};
+
+void NetLinkWrapper::getter_buffer_pool(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->buffer_pool != nullptr)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        info.GetReturnValue().Set(obj->buffer_pool_handle.Get(isolate));
+    }
+    // else no pool, so this will return undefined
+};
+
+void NetLinkWrapper::getter_is_blocking(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(obj->blocking));
+};
+
+void NetLinkWrapper::getter_max_datagram_size(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(obj->max_datagram_size));
+};
+
+void NetLinkWrapper::getter_read_ahead(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->socket == nullptr)
+    {
+        info.GetReturnValue().Set(Nan::New(0));
+        return;
+    }
+
+    auto capacity = static_cast<double>(obj->socket->readAhead());
+    info.GetReturnValue().Set(Nan::New(capacity));
+};
+
+void NetLinkWrapper::getter_read_ahead_bytes_served(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->socket == nullptr)
     {
+        info.GetReturnValue().Set(Nan::New(0));
         return;
     }
 
-    try
-    {
+    auto served = static_cast<double>(obj->socket->readAheadServed());
+    info.GetReturnValue().Set(Nan::New(served));
+};
 
-        obj->socket->blocking(blocking);
-    }
-    catch (NL::Exception &err)
+void NetLinkWrapper::getter_read_ahead_refills(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->socket == nullptr)
     {
-        throw_js_error(err);
+        info.GetReturnValue().Set(Nan::New(0));
         return;
     }
-}
 
-void NetLinkWrapper::send(const v8::FunctionCallbackInfo<v8::Value> &args)
+    auto refills = static_cast<double>(obj->socket->readAheadRefills());
+    info.GetReturnValue().Set(Nan::New(refills));
+};
+
+void NetLinkWrapper::getter_gro(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
 {
-    std::string data;
-    if (ArgParser(args)
-            .arg("data", data, GetValue::SubType::SendableData)
-            .isInvalid())
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(obj->socket != nullptr && obj->socket->gro()));
+};
+
+void NetLinkWrapper::getter_write_queue(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(obj->socket != nullptr && obj->socket->writeQueue()));
+};
+
+void NetLinkWrapper::getter_write_queue_size(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->socket == nullptr)
     {
+        info.GetReturnValue().Set(Nan::New(0));
         return;
     }
 
-    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
-    if (obj->throw_if_destroyed())
+    auto size = static_cast<double>(obj->socket->writeQueueSize());
+    info.GetReturnValue().Set(Nan::New(size));
+};
+
+void NetLinkWrapper::getter_zero_copy(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(obj->socket != nullptr && obj->socket->zeroCopy()));
+};
+
+void NetLinkWrapper::getter_zero_copy_completed(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->socket == nullptr)
     {
+        info.GetReturnValue().Set(Nan::New(0));
         return;
     }
 
     try
     {
-
-        obj->socket->send(data.c_str(), data.length());
+        obj->release_zero_copy_strings();
+        auto completed = static_cast<double>(obj->socket->zeroCopyCompleted());
+        info.GetReturnValue().Set(Nan::New(completed));
     }
     catch (NL::Exception &err)
     {
         throw_js_error(err);
         return;
     }
-}
+};
 
-void NetLinkWrapper::send_to(const v8::FunctionCallbackInfo<v8::Value> &args)
+void NetLinkWrapper::getter_zero_copy_copied(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
 {
-
-    std::string host;
-    std::uint16_t port = 0;
-    std::string data;
-    if (ArgParser(args)
-            .arg("host", host)
-            .arg("port", port)
-            .arg("data", data, GetValue::SubType::SendableData)
-            .isInvalid())
-    {
-        return;
-    }
-
-    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(args.Holder());
-    if (obj->throw_if_destroyed())
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->socket == nullptr)
     {
+        info.GetReturnValue().Set(Nan::New(0));
         return;
     }
 
     try
     {
-
-        obj->socket->sendTo(data.c_str(), data.length(), host, port);
+        auto copied = static_cast<double>(obj->socket->zeroCopyCopied());
+        info.GetReturnValue().Set(Nan::New(copied));
     }
     catch (NL::Exception &err)
     {
         throw_js_error(err);
         return;
     }
-}
+};
 
-/* -- Getters -- */
+void NetLinkWrapper::getter_zero_copy_sent(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->socket == nullptr)
+    {
+        info.GetReturnValue().Set(Nan::New(0));
+        return;
+    }
 
-void NetLinkWrapper::getter_is_blocking(
+    auto sent = static_cast<double>(obj->socket->zeroCopySent());
+    info.GetReturnValue().Set(Nan::New(sent));
+};
+
+void NetLinkWrapper::getter_zero_copy_threshold(
     v8::Local<v8::String>,
     const v8::PropertyCallbackInfo<v8::Value> &info)
 {
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    auto threshold = obj->socket == nullptr ? DEFAULT_ZERO_COPY_THRESHOLD : obj->socket->zeroCopyThreshold();
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(threshold)));
+};
 
+void NetLinkWrapper::getter_is_corked(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
     auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
-    info.GetReturnValue().Set(Nan::New(obj->blocking));
+    info.GetReturnValue().Set(Nan::New(obj->socket != nullptr && obj->socket->cork()));
+};
+
+void NetLinkWrapper::getter_is_connected(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(obj->socket != nullptr && obj->socket->connected()));
 };
 
 void NetLinkWrapper::getter_is_destroyed(
@@ -683,6 +2640,211 @@ void NetLinkWrapper::setter_throw_exception(
     isolate->ThrowException(v8::Exception::Error(v8_str(ss.str())));
 }
 
+void NetLinkWrapper::setter_address_cache_size(
+    v8::Local<v8::String>,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void> &info)
+{
+    std::uint32_t size = 0;
+    auto error_message = GetValue::get_value(size, value, GetValue::SubType::None);
+    if (error_message.length() > 0)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Value to set \"addressCacheSize\" to " + error_message)));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    obj->address_cache.capacity(size);
+}
+
+void NetLinkWrapper::setter_buffer_pool(
+    v8::Local<v8::String>,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void> &info)
+{
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+
+    if (value->IsUndefined() || value->IsNull())
+    {
+        obj->buffer_pool = nullptr;
+        obj->buffer_pool_handle.Reset();
+        return;
+    }
+
+    auto buffer_pool = BufferPool::from_value(value);
+    if (buffer_pool == nullptr)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Value to set \"bufferPool\" to must be a BufferPool or undefined.")));
+        return;
+    }
+
+    auto isolate = v8::Isolate::GetCurrent();
+    obj->buffer_pool = buffer_pool;
+    obj->buffer_pool_handle.Reset(isolate, value.As<v8::Object>());
+}
+
+void NetLinkWrapper::setter_max_datagram_size(
+    v8::Local<v8::String>,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void> &info)
+{
+    std::uint32_t size = 0;
+    auto error = GetValue::get_value(size, value, GetValue::SubType::None);
+    if (error.length() || size == 0 || size > MAX_DATAGRAM_SIZE)
+    {
+        std::stringstream ss;
+        ss << "Value to set \"maxDatagramSize\" to must be a number from 1 to "
+           << MAX_DATAGRAM_SIZE << ".";
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::RangeError(v8_str(ss.str())));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    obj->max_datagram_size = size;
+    if (obj->datagram_scratch.size() > size)
+    {
+        // give back memory from a previously larger size
+        obj->datagram_scratch.resize(size);
+        obj->datagram_scratch.shrink_to_fit();
+    }
+}
+
+void NetLinkWrapper::setter_read_ahead(
+    v8::Local<v8::String>,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void> &info)
+{
+    std::uint32_t capacity = 0;
+    auto error_message = GetValue::get_value(capacity, value, GetValue::SubType::None);
+    if (error_message.length() > 0)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Value to set \"readAhead\" to " + error_message)));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    try
+    {
+        obj->socket->readAhead(capacity);
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+}
+
+void NetLinkWrapper::setter_gro(
+    v8::Local<v8::String>,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void> &info)
+{
+    if (!value->IsBoolean())
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Value to set \"gro\" to must be a boolean.")));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    try
+    {
+        obj->socket->gro(value->IsTrue());
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+}
+
+void NetLinkWrapper::setter_write_queue(
+    v8::Local<v8::String>,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void> &info)
+{
+    if (!value->IsBoolean())
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Value to set \"writeQueue\" to must be a boolean.")));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    obj->socket->writeQueue(value->IsTrue());
+}
+
+void NetLinkWrapper::setter_zero_copy(
+    v8::Local<v8::String>,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void> &info)
+{
+    if (!value->IsBoolean())
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Value to set \"zeroCopy\" to must be a boolean.")));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    try
+    {
+        obj->socket->zeroCopy(value->IsTrue());
+    }
+    catch (NL::Exception &err)
+    {
+        throw_js_error(err);
+        return;
+    }
+}
+
+void NetLinkWrapper::setter_zero_copy_threshold(
+    v8::Local<v8::String>,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void> &info)
+{
+    std::uint32_t threshold = 0;
+    auto error_message = GetValue::get_value(threshold, value, GetValue::SubType::None);
+    if (error_message.length() > 0)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Value to set \"zeroCopyThreshold\" to " + error_message)));
+        return;
+    }
+
+    auto obj = node::ObjectWrap::Unwrap<NetLinkWrapper>(info.Holder());
+    if (obj->throw_if_destroyed())
+    {
+        return;
+    }
+
+    obj->socket->zeroCopyThreshold(threshold);
+}
+
 void NetLinkWrapper::setter_is_blocking(
     v8::Local<v8::String>,
     v8::Local<v8::Value> value,
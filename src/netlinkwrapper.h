@@ -2,19 +2,70 @@
 #define NETLINKOBJECT_H
 
 #include <cstdint>
+#include <deque>
 #include <node.h>
 #include <node_object_wrap.h>
 #include <string>
+#include <vector>
+#include "address_cache.h"
+#include "buffer_pool.h"
+#include "endpoint.h"
+#include "framing.h"
+#include "netlink/smart_buffer.h"
 #include "netlink/socket.h"
 
+v8::Local<v8::String> v8_str(const char *str);
+v8::Local<v8::String> v8_str(const std::string &str);
+void throw_js_error(NL::Exception &err);
+
+#define DEFAULT_MAX_DATAGRAM_SIZE 65507
+
 class NetLinkWrapper : public node::ObjectWrap
 {
 public:
     static void init(v8::Local<v8::Object> exports);
 
+    // shared by other wrapped classes for their readonly properties
+    static void setter_throw_exception(
+        v8::Local<v8::String>,
+        v8::Local<v8::Value>,
+        const v8::PropertyCallbackInfo<void> &);
+
+    // Wraps a connected NL TCP client socket in a new SocketClientTCP,
+    // which takes ownership of it.
+    static v8::Local<v8::Object> wrap_tcp_client(NL::Socket *socket);
+
 private:
     NL::Socket *socket;
 
+    // optional pool received Buffers are carved from, kept alive by handle
+    BufferPool *buffer_pool = nullptr;
+    v8::Global<v8::Object> buffer_pool_handle;
+
+    // data framed, delimited, and line receives read from the socket but did
+    // not hand to JS yet, such as partial frames. Created on first use.
+    // It sits above the socket's own read-ahead (the readAhead property),
+    // which only batches the system calls reads are served from, so plain
+    // receives drain this first and then the socket.
+    NL::SmartBuffer *frame_buffer = nullptr;
+    Framing::Prefix frame_prefix = Framing::Prefix::None;
+    std::uint32_t max_frame_length = DEFAULT_MAX_FRAME_LENGTH;
+
+    // receiveFrom receives each datagram whole into this, then copies it out
+    std::uint32_t max_datagram_size = DEFAULT_MAX_DATAGRAM_SIZE;
+    std::vector<char> datagram_scratch;
+
+    // the start of a multi-byte character cut short by the end of the last
+    // receiveString, prepended to the next one
+    std::vector<char> string_pending;
+
+    // host strings of the peers datagrams were received from
+    AddressCache address_cache;
+
+    // strings encoded for zero copy sends, by the zeroCopySent() count that
+    // sent them. Freed once the kernel is done with them.
+    std::deque<std::pair<unsigned long long, std::string>> zero_copy_strings;
+
     // accessed via getters, so we cache them here
     bool blocking = true;
     NL::IPVer ip_version;
@@ -28,6 +79,11 @@ private:
     ~NetLinkWrapper();
 
     bool throw_if_destroyed();
+    bool throw_if_wrong_ip_version(const Endpoint *endpoint);
+    std::size_t take_frame_buffer(char *buffer, std::size_t size);
+    bool fill_frame_buffer(bool wait);
+    bool read_into(std::vector<char> &into, std::size_t max_bytes);
+    void release_zero_copy_strings();
 
     static v8::Persistent<v8::FunctionTemplate> class_socket_base;
     static v8::Persistent<v8::FunctionTemplate> class_socket_tcp_client;
@@ -40,14 +96,34 @@ private:
     static void new_tcp_server(const v8::FunctionCallbackInfo<v8::Value> &args);
     static void new_udp(const v8::FunctionCallbackInfo<v8::Value> &args);
 
+    /* -- Static Methods -- */
+    static void connect_tcp_client(const v8::FunctionCallbackInfo<v8::Value> &args);
+
     /* -- Methods -- */
     static void accept(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void connect(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void cork(const v8::FunctionCallbackInfo<v8::Value> &args);
     static void disconnect(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void flush(const v8::FunctionCallbackInfo<v8::Value> &args);
     static void receive(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void receive_datagram(const v8::FunctionCallbackInfo<v8::Value> &args);
     static void receive_from(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void receive_lines(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void receive_messages(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void receive_string(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void receive_until(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void receive_from_many(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void receive_from_raw(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void receive_from_into(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void receive_into(const v8::FunctionCallbackInfo<v8::Value> &args);
     static void set_blocking(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void set_framing(const v8::FunctionCallbackInfo<v8::Value> &args);
     static void send(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void send_file(const v8::FunctionCallbackInfo<v8::Value> &args);
     static void send_to(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void send_to_many(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void send_to_segmented(const v8::FunctionCallbackInfo<v8::Value> &args);
+    static void uncork(const v8::FunctionCallbackInfo<v8::Value> &args);
 
     /* -- Getters -- */
     static void getter_host_from(
@@ -63,9 +139,63 @@ private:
         v8::Local<v8::String>,
         const v8::PropertyCallbackInfo<v8::Value> &info);
 
+    static void getter_address_cache_hits(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_address_cache_misses(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_address_cache_size(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_buffer_pool(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_gro(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
     static void getter_is_blocking(
         v8::Local<v8::String>,
         const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_max_datagram_size(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_read_ahead(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_read_ahead_bytes_served(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_read_ahead_refills(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_write_queue(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_write_queue_size(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_zero_copy(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_zero_copy_completed(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_zero_copy_copied(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_zero_copy_sent(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_zero_copy_threshold(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_is_corked(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_is_connected(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
     static void getter_is_destroyed(
         v8::Local<v8::String>,
         const v8::PropertyCallbackInfo<v8::Value> &info);
@@ -77,10 +207,38 @@ private:
         const v8::PropertyCallbackInfo<v8::Value> &info);
 
     /* -- Setters -- */
-    static void setter_throw_exception(
+    static void setter_address_cache_size(
         v8::Local<v8::String>,
-        v8::Local<v8::Value>,
-        const v8::PropertyCallbackInfo<void> &);
+        v8::Local<v8::Value> value,
+        const v8::PropertyCallbackInfo<void> &info);
+    static void setter_buffer_pool(
+        v8::Local<v8::String>,
+        v8::Local<v8::Value> value,
+        const v8::PropertyCallbackInfo<void> &info);
+    static void setter_max_datagram_size(
+        v8::Local<v8::String>,
+        v8::Local<v8::Value> value,
+        const v8::PropertyCallbackInfo<void> &info);
+    static void setter_read_ahead(
+        v8::Local<v8::String>,
+        v8::Local<v8::Value> value,
+        const v8::PropertyCallbackInfo<void> &info);
+    static void setter_gro(
+        v8::Local<v8::String>,
+        v8::Local<v8::Value> value,
+        const v8::PropertyCallbackInfo<void> &info);
+    static void setter_write_queue(
+        v8::Local<v8::String>,
+        v8::Local<v8::Value> value,
+        const v8::PropertyCallbackInfo<void> &info);
+    static void setter_zero_copy(
+        v8::Local<v8::String>,
+        v8::Local<v8::Value> value,
+        const v8::PropertyCallbackInfo<void> &info);
+    static void setter_zero_copy_threshold(
+        v8::Local<v8::String>,
+        v8::Local<v8::Value> value,
+        const v8::PropertyCallbackInfo<void> &info);
     static void setter_is_blocking(
         v8::Local<v8::String>,
         v8::Local<v8::Value> value,
@@ -0,0 +1,125 @@
+#include <cstdint>
+#include <nan.h>
+#include "get_value.h"
+#include "netlinkwrapper.h"
+#include "netlink/resolver.h"
+#include "resolver_wrapper.h"
+
+void ResolverWrapper::init(v8::Local<v8::Object> exports)
+{
+    auto isolate = v8::Isolate::GetCurrent();
+
+    auto resolver_template = v8::ObjectTemplate::New(isolate);
+
+    resolver_template->SetAccessor(
+        v8_str("cacheHits"),
+        getter_cache_hits,
+        NetLinkWrapper::setter_throw_exception);
+
+    resolver_template->SetAccessor(
+        v8_str("cacheMisses"),
+        getter_cache_misses,
+        NetLinkWrapper::setter_throw_exception);
+
+    resolver_template->SetAccessor(
+        v8_str("cacheSize"),
+        getter_cache_size,
+        setter_cache_size);
+
+    resolver_template->SetAccessor(
+        v8_str("cacheTtl"),
+        getter_cache_ttl,
+        setter_cache_ttl);
+
+    resolver_template->SetAccessor(
+        v8_str("numericHits"),
+        getter_numeric_hits,
+        NetLinkWrapper::setter_throw_exception);
+
+    resolver_template->Set(
+        v8_str("clearCache"),
+        v8::FunctionTemplate::New(isolate, clear_cache));
+
+    auto resolver = resolver_template->NewInstance(Nan::GetCurrentContext()).ToLocalChecked();
+    Nan::Set(exports, v8_str("resolver"), resolver);
+}
+
+/* -- JS methods -- */
+
+void ResolverWrapper::clear_cache(const v8::FunctionCallbackInfo<v8::Value> &args)
+{
+    NL::Resolver::clearCache();
+}
+
+/* -- Getters -- */
+
+void ResolverWrapper::getter_cache_hits(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(NL::Resolver::cacheHits())));
+}
+
+void ResolverWrapper::getter_cache_misses(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(NL::Resolver::cacheMisses())));
+}
+
+void ResolverWrapper::getter_cache_size(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(NL::Resolver::cacheSize())));
+}
+
+void ResolverWrapper::getter_cache_ttl(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(NL::Resolver::cacheTtl())));
+}
+
+void ResolverWrapper::getter_numeric_hits(
+    v8::Local<v8::String>,
+    const v8::PropertyCallbackInfo<v8::Value> &info)
+{
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(NL::Resolver::numericHits())));
+}
+
+/* -- Setters -- */
+
+void ResolverWrapper::setter_cache_size(
+    v8::Local<v8::String>,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void> &info)
+{
+    std::uint32_t size = 0;
+    auto error_message = GetValue::get_value(size, value, GetValue::SubType::None);
+    if (error_message.length() > 0)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Value to set \"cacheSize\" to " + error_message)));
+        return;
+    }
+
+    NL::Resolver::cacheSize(size);
+}
+
+void ResolverWrapper::setter_cache_ttl(
+    v8::Local<v8::String>,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void> &info)
+{
+    std::uint32_t ttl = 0;
+    auto error_message = GetValue::get_value(ttl, value, GetValue::SubType::None);
+    if (error_message.length() > 0)
+    {
+        auto isolate = v8::Isolate::GetCurrent();
+        isolate->ThrowException(v8::Exception::Error(v8_str("Value to set \"cacheTtl\" to " + error_message)));
+        return;
+    }
+
+    NL::Resolver::cacheTtl(ttl);
+}
@@ -0,0 +1,45 @@
+#ifndef RESOLVER_WRAPPER_H
+#define RESOLVER_WRAPPER_H
+
+#include <node.h>
+
+// Exposes the process wide NL::Resolver, which every socket resolves its
+// hosts through, as the `resolver` export so it can be tuned and monitored.
+class ResolverWrapper
+{
+public:
+    static void init(v8::Local<v8::Object> exports);
+
+private:
+    /* -- Methods -- */
+    static void clear_cache(const v8::FunctionCallbackInfo<v8::Value> &args);
+
+    /* -- Getters -- */
+    static void getter_cache_hits(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_cache_misses(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_cache_size(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_cache_ttl(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void getter_numeric_hits(
+        v8::Local<v8::String>,
+        const v8::PropertyCallbackInfo<v8::Value> &info);
+
+    /* -- Setters -- */
+    static void setter_cache_size(
+        v8::Local<v8::String>,
+        v8::Local<v8::Value> value,
+        const v8::PropertyCallbackInfo<void> &info);
+    static void setter_cache_ttl(
+        v8::Local<v8::String>,
+        v8::Local<v8::Value> value,
+        const v8::PropertyCallbackInfo<void> &info);
+};
+
+#endif
@@ -0,0 +1,113 @@
+#include <limits>
+#include <vector>
+#include "byte_scan.h"
+#include "string_decode.h"
+
+std::size_t StringDecode::utf8_complete_length(const char *data, std::size_t length)
+{
+    auto bytes = reinterpret_cast<const unsigned char *>(data);
+
+    // a sequence is at most 4 bytes, so only the last 3 can start one that
+    // is still missing bytes
+    for (std::size_t back = 1; back <= 3 && back <= length; back++)
+    {
+        auto byte = bytes[length - back];
+        if (byte < 0x80)
+        {
+            return length; // ASCII, so nothing is cut short
+        }
+
+        if (byte >= 0xC0)
+        {
+            // a lead byte, does it have all of its continuation bytes?
+            std::size_t needed = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : 2;
+            if (byte >= 0xF8 || back >= needed)
+            {
+                return length; // complete, or invalid anyway
+            }
+            return length - back;
+        }
+        // else a continuation byte, keep looking back for its lead
+    }
+
+    return length;
+}
+
+v8::MaybeLocal<v8::String> StringDecode::decode(
+    const char *data,
+    std::size_t length,
+    Encoding encoding)
+{
+    if (length > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+    {
+        return v8::MaybeLocal<v8::String>();
+    }
+
+    auto size = static_cast<int>(length);
+    auto one_byte = reinterpret_cast<const std::uint8_t *>(data);
+
+    if (encoding == Latin1)
+    {
+        return Nan::NewOneByteString(one_byte, size);
+    }
+
+    // pure ASCII is the same in every encoding, and one-byte strings skip
+    // V8's UTF-8 decoder entirely
+    auto ascii = ByteScan::ascii_length(data, length);
+    if (ascii == length)
+    {
+        return Nan::NewOneByteString(one_byte, size);
+    }
+
+    if (encoding == Ascii)
+    {
+        // like Node, unset the high bit of each byte and decode as latin1
+        std::vector<std::uint8_t> masked(one_byte, one_byte + length);
+        for (auto i = ascii; i < length; i++)
+        {
+            masked[i] &= 0x7F;
+        }
+        return Nan::NewOneByteString(masked.data(), size);
+    }
+
+    // invalid sequences become U+FFFD, the same as Buffer.toString()
+    return Nan::New(data, size);
+}
+
+std::size_t StringDecode::encode_utf8(v8::Local<v8::String> str, std::vector<char> &into)
+{
+    auto isolate = v8::Isolate::GetCurrent();
+    auto start = into.size();
+    auto length = static_cast<std::size_t>(str->Length());
+
+    if (str->IsOneByte())
+    {
+        into.resize(start + length);
+        str->WriteOneByte(
+            isolate,
+            reinterpret_cast<std::uint8_t *>(into.data() + start),
+            0,
+            static_cast<int>(length),
+            v8::String::NO_NULL_TERMINATION);
+
+        if (ByteScan::ascii_length(into.data() + start, length) == length)
+        {
+            return length; // ASCII is already UTF-8
+        }
+
+        // latin1 beyond ASCII takes two bytes per character as UTF-8
+        into.resize(start);
+    }
+
+    // each UTF-16 code unit is at most 3 bytes of UTF-8
+    into.resize(start + 3 * length);
+    auto written = str->WriteUtf8(
+        isolate,
+        into.data() + start,
+        static_cast<int>(3 * length),
+        nullptr,
+        v8::String::NO_NULL_TERMINATION | v8::String::REPLACE_INVALID_UTF8);
+    into.resize(start + written);
+
+    return static_cast<std::size_t>(written);
+}
@@ -0,0 +1,36 @@
+#ifndef STRING_DECODE_H
+#define STRING_DECODE_H
+
+#include <cstddef>
+#include <nan.h>
+#include <vector>
+
+namespace StringDecode
+{
+    // The encodings received data can be decoded from, as named by Node.
+    enum Encoding
+    {
+        Utf8,
+        Latin1,
+        Ascii,
+    };
+
+    // Gets how many bytes at the start of data are whole UTF-8 sequences.
+    // A trailing sequence cut short (such as by the end of a read) is
+    // excluded, so it can be completed by the data that follows it.
+    std::size_t utf8_complete_length(const char *data, std::size_t length);
+
+    // Creates a JS string straight from received bytes, decoding them the same
+    // way Buffer.toString(encoding) would. Empty if the string is too long.
+    v8::MaybeLocal<v8::String> decode(
+        const char *data,
+        std::size_t length,
+        Encoding encoding);
+
+    // Appends a JS string to into as UTF-8, the same bytes Buffer.from(str)
+    // would hold, and returns how many were appended. ASCII strings are
+    // copied straight out of V8, and into only allocates when it has to grow.
+    std::size_t encode_utf8(v8::Local<v8::String> str, std::vector<char> &into);
+} // namespace StringDecode
+
+#endif
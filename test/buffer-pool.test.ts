@@ -0,0 +1,92 @@
+import { expect } from "chai";
+import { BufferPool, SocketUDP } from "../lib";
+import { badArg, tcpClientTester } from "./utils";
+
+describe("BufferPool", function () {
+    it("can be constructed with defaults", function () {
+        const pool = new BufferPool();
+        expect(pool.slabSize).to.be.greaterThan(0);
+        expect(pool.highWaterMark).to.be.greaterThan(0);
+        expect(pool.hits).to.equal(0);
+        expect(pool.misses).to.equal(0);
+        expect(pool.bytesInFlight).to.equal(0);
+    });
+
+    it("throws with invalid args", function () {
+        expect(() => new BufferPool(0)).to.throw(RangeError);
+        expect(() => new BufferPool(badArg())).to.throw(TypeError);
+    });
+
+    it("cannot set readonly properties", function () {
+        const pool = new BufferPool() as { -readonly [K in "hits"]: number };
+        expect(() => {
+            pool.hits = badArg();
+        }).to.throw();
+    });
+
+    it("does not release Buffers it did not create", function () {
+        const pool = new BufferPool();
+        expect(pool.release(Buffer.from("not pooled"))).to.be.false;
+    });
+
+    it("cannot be set as an invalid bufferPool", function () {
+        const udp = new SocketUDP();
+        expect(() => {
+            udp.bufferPool = badArg();
+        }).to.throw();
+        udp.disconnect();
+    });
+
+    tcpClientTester.testPermutations((testing) => {
+        it("can receive pooled Buffers", async function () {
+            const pool = new BufferPool(1024);
+            testing.netLink.bufferPool = pool;
+            expect(testing.netLink.bufferPool).to.equal(pool);
+
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(testing.str);
+            void (await sentPromise);
+
+            const read = testing.netLink.receive();
+            expect(read?.toString()).to.equal(testing.str);
+            expect(pool.misses).to.equal(1);
+            expect(pool.bytesInFlight).to.equal(read?.length);
+
+            expect(read && pool.release(read)).to.be.true;
+            expect(pool.bytesInFlight).to.equal(0);
+
+            testing.netLink.bufferPool = undefined;
+            expect(testing.netLink.bufferPool).to.be.undefined;
+        });
+
+        it("releases each pooled Buffer only once", async function () {
+            const pool = new BufferPool(1024);
+            testing.netLink.bufferPool = pool;
+
+            const receiveOne = async (data: string) => {
+                const sentPromise = testing.echo.events.sentData.once();
+                testing.netLink.send(data);
+                void (await sentPromise);
+                const read = testing.netLink.receive();
+                if (!read) {
+                    throw new Error(`Did not receive "${data}"`);
+                }
+                return read;
+            };
+
+            const first = await receiveOne("first");
+            const second = await receiveOne("second");
+
+            expect(pool.release(first)).to.be.true;
+            expect(pool.release(first)).to.be.false;
+            expect(pool.release(second.subarray(1))).to.be.false;
+
+            // second is still outstanding, so its memory must not be reused
+            const third = await receiveOne("third");
+            expect(second.toString()).to.equal("second");
+            expect(third.toString()).to.equal("third");
+
+            testing.netLink.bufferPool = undefined;
+        });
+    });
+});
@@ -14,7 +14,11 @@ describe("client shared functionality", function () {
                     : testing.port;
 
             const send = (
-                data: string | Buffer | Uint8Array = testing.str,
+                data:
+                    | string
+                    | Buffer
+                    | Uint8Array
+                    | Array<string | Buffer | Uint8Array> = testing.str,
                 client = testing.netLink,
             ) => {
                 if (client instanceof SocketUDP) {
@@ -48,6 +52,20 @@ describe("client shared functionality", function () {
                 expect(read?.compare(sent.buffer)).to.equal(0);
             });
 
+            it("can send non-ASCII strings as UTF-8", async function () {
+                // one-byte latin1 and two-byte strings are encoded differently
+                const strs = [`${testing.str} \u00e9\u00ff`, "\u20ac\u{1f600}"];
+                for (const str of strs) {
+                    const dataPromise = testing.echo.events.sentData.once();
+                    send(str);
+                    const sent = await dataPromise;
+                    expect(sent.buffer.compare(Buffer.from(str))).to.equal(0);
+
+                    const read = receive();
+                    expect(read?.toString()).to.equal(str);
+                }
+            });
+
             it("can send Buffers", async function () {
                 const dataPromise = testing.echo.events.sentData.once();
 
@@ -73,6 +91,38 @@ describe("client shared functionality", function () {
                 expect(read?.toString()).to.equal(testing.str);
             });
 
+            it("can send views into larger Buffers", async function () {
+                const dataPromise = testing.echo.events.sentData.once();
+
+                const padded = Buffer.from(`[${testing.str}]`);
+                send(padded.subarray(1, padded.length - 1));
+                const sent = await dataPromise;
+                expect(sent.str).to.equal(testing.str); // should be echoed back
+
+                const read = receive();
+                expect(read?.toString()).to.equal(testing.str);
+            });
+
+            it("can send arrays of data together", async function () {
+                const dataPromise = testing.echo.events.sentData.once();
+
+                const half = Math.floor(testing.str.length / 2);
+                send([
+                    Buffer.from(testing.str.slice(0, half)),
+                    new Uint8Array(0),
+                    testing.str.slice(half),
+                ]);
+                const sent = await dataPromise;
+                expect(sent.str).to.equal(testing.str); // should be echoed back
+
+                const read = receive();
+                expect(read?.toString()).to.equal(testing.str);
+            });
+
+            it("cannot send arrays of invalid data", function () {
+                expect(() => send([testing.str, badArg()])).to.throw();
+            });
+
             it("cannot send invalid date", function () {
                 expect(() => send(badArg())).to.throw();
             });
@@ -0,0 +1,37 @@
+import { expect } from "chai";
+import { Endpoint } from "../lib";
+import { badArg } from "./utils";
+
+describe("Endpoint", function () {
+    it("resolves hosts once constructed", function () {
+        const endpoint = new Endpoint("localhost", 1234);
+        expect(endpoint.host).to.equal("127.0.0.1");
+        expect(endpoint.port).to.equal(1234);
+        expect(endpoint.isIPv4).to.be.true;
+        expect(endpoint.isIPv6).to.be.false;
+    });
+
+    it("can be constructed for IPv6", function () {
+        const endpoint = new Endpoint("::1", 1234, "IPv6");
+        expect(endpoint.host).to.equal("::1");
+        expect(endpoint.isIPv4).to.be.false;
+        expect(endpoint.isIPv6).to.be.true;
+    });
+
+    it("throws with invalid args", function () {
+        expect(() => new Endpoint(badArg(), 1234)).to.throw(TypeError);
+        expect(() => new Endpoint("localhost", badArg())).to.throw(TypeError);
+        expect(() => new Endpoint("localhost", 1234, badArg())).to.throw(
+            TypeError,
+        );
+    });
+
+    it("cannot set readonly properties", function () {
+        const endpoint = new Endpoint("localhost", 1234) as {
+            -readonly [K in "port"]: number;
+        };
+        expect(() => {
+            endpoint.port = badArg();
+        }).to.throw();
+    });
+});
@@ -3,10 +3,13 @@ import { expect } from "chai";
 
 describe("module", function () {
     it("has named exports", function () {
+        expect(module.BufferPool).to.exist;
+        expect(module.Endpoint).to.exist;
         expect(module.SocketBase).to.exist;
         expect(module.SocketClientTCP).to.exist;
         expect(module.SocketServerTCP).to.exist;
         expect(module.SocketUDP).to.exist;
+        expect(module.resolver).to.exist;
     });
 
     it("cannot be constructed as a base class.", function () {
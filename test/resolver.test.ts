@@ -0,0 +1,77 @@
+import { expect } from "chai";
+import { resolver, SocketUDP } from "../lib";
+import { badArg } from "./utils";
+
+describe("resolver", function () {
+    const defaults = {
+        cacheSize: resolver.cacheSize,
+        cacheTtl: resolver.cacheTtl,
+    };
+    let udp: SocketUDP;
+
+    beforeEach(function () {
+        resolver.clearCache();
+        udp = new SocketUDP(undefined, "localhost");
+    });
+
+    afterEach(function () {
+        udp.disconnect();
+        resolver.cacheSize = defaults.cacheSize;
+        resolver.cacheTtl = defaults.cacheTtl;
+    });
+
+    it("has defaults", function () {
+        expect(defaults.cacheSize).to.be.greaterThan(0);
+        expect(defaults.cacheTtl).to.be.greaterThan(0);
+    });
+
+    it("cannot set readonly properties", function () {
+        const settable = resolver as {
+            -readonly [K in "cacheHits"]: number;
+        };
+        expect(() => {
+            settable.cacheHits = badArg();
+        }).to.throw();
+    });
+
+    it("cannot set invalid values", function () {
+        expect(() => {
+            resolver.cacheSize = badArg();
+        }).to.throw();
+        expect(() => {
+            resolver.cacheTtl = -1;
+        }).to.throw();
+    });
+
+    it("parses numeric hosts without looking them up", function () {
+        const { numericHits, cacheMisses } = resolver;
+        udp.sendTo("127.0.0.1", udp.portFrom, "numeric");
+
+        expect(resolver.numericHits).to.equal(numericHits + 1);
+        expect(resolver.cacheMisses).to.equal(cacheMisses);
+        expect(udp.receiveFrom()?.data.toString()).to.equal("numeric");
+    });
+
+    it("caches names it looked up", function () {
+        const { cacheHits, cacheMisses } = resolver;
+        udp.sendTo("localhost", udp.portFrom, "first");
+        udp.sendTo("localhost", udp.portFrom, "second");
+
+        expect(resolver.cacheMisses).to.equal(cacheMisses + 1);
+        expect(resolver.cacheHits).to.equal(cacheHits + 1);
+        expect(udp.receiveFrom()?.data.toString()).to.equal("first");
+        expect(udp.receiveFrom()?.data.toString()).to.equal("second");
+    });
+
+    it("does not cache names when the cache size is 0", function () {
+        resolver.cacheSize = 0;
+        expect(resolver.cacheSize).to.equal(0);
+
+        const { cacheHits, cacheMisses } = resolver;
+        udp.sendTo("localhost", udp.portFrom, "first");
+        udp.sendTo("localhost", udp.portFrom, "second");
+
+        expect(resolver.cacheMisses).to.equal(cacheMisses + 2);
+        expect(resolver.cacheHits).to.equal(cacheHits);
+    });
+});
@@ -1,5 +1,8 @@
 import { expect } from "chai";
+import { closeSync, openSync, unlinkSync, writeFileSync } from "fs";
 import { Socket } from "net";
+import { tmpdir } from "os";
+import { join } from "path";
 import { SocketClientTCP } from "../lib";
 import {
     badArg,
@@ -7,6 +10,7 @@ import {
     badIPAddress,
     EchoClientTCP,
     getNextTestingPort,
+    SaturatedListenerTCP,
     tcpClientTester,
 } from "./utils";
 
@@ -57,6 +61,93 @@ describe("TCP Client", function () {
                 () => new SocketClientTCP(1234, badIPAddress, ipVersion),
             ).to.throw();
         });
+
+        it("can connect asynchronously", async function () {
+            const echoServer = new EchoClientTCP();
+            const port = getNextTestingPort();
+            await echoServer.start({ port });
+
+            const connected = echoServer.events.newConnection.once();
+            const tcp = await SocketClientTCP.connect(
+                port,
+                "localhost",
+                ipVersion,
+            );
+            expect(tcp).to.be.instanceOf(SocketClientTCP);
+            expect(tcp.portTo).to.equal(port);
+            await connected;
+
+            tcp.disconnect();
+x, function () {
+        let listener: SaturatedListenerTCP;
+
+        beforeEach(function () {
+            listener = new SaturatedListenerTCP();
+            if (!listener.saturate()) {
+                listener.close();
+                this.skip();
+            }
+        });
+
+        afterEach(function () {
+            listener.close();
+        });
+
+        it("throws once its connect timeout passes", function () {
+            const { host, port } = listener;
+            const started = Date.now();
+            expect(
+                () => new SocketClientTCP(port, host, "IPv4", 500),
+            ).to.throw(/timed out connecting/);
+            expect(Date.now() - started).to.be.within(450, 5_000);
+        });
+
+        it("rejects once its connect timeout passes", async function () {
+            const { host, port } = listener;
+            const started = Date.now();
+            const error = await SocketClientTCP.connect(
+                port,
+                host,
+                "IPv4",
+                500,
+            ).then(
+                () => null,
+                (err: unknown) => err,
+            );
+            expect(error).to.be.instanceOf(Error);
+            expect(String(error)).to.match(/timed out connecting/);
+            expect(Date.now() - started).to.be.within(450, 5_000);
+        });
+
+        it("gives up racing addresses once its timeout passes", function () {
+            const { host, port } = listener;
+            const started = Date.now();
+            expect(
+                () => new SocketClientTCP(port, host, "any", 500, 50),
+            ).to.throw(/timed out connecting/);
+            expect(Date.now() - started).to.be.within(450, 5_000);
+        });
+    });
+
+    it("can race the addresses of either IP version", async function () {
+        const echoServer = new EchoClientTCP();
+        const port = getNextTestingPort();
+        await echoServer.start({ port });
+
+        const connected = echoServer.events.newConnection.once();
+        const tcp = new SocketClientTCP(port, "localhost", "any", 0, 50);
+        await connected;
+        expect(tcp.isIPv4 || tcp.isIPv6).to.be.true;
+        expect(tcp.isIPv4 && tcp.isIPv6).to.be.false;
+
+        tcp.disconnect();
+        await echoServer.stop();
+    });
+
+    it("cannot race addresses with an invalid connectStagger", function () {
+        expect(
+            () => new SocketClientTCP(1234, "localhost", "any", 0, badArg()),
+        ).to.throw(TypeError);
     });
 
     tcpClientTester.testPermutations((testing) => {
@@ -85,5 +176,378 @@ describe("TCP Client", function () {
                 testing.settableNetLink.portTo = badArg();
             }).to.throw();
         });
+
+        it("can receive with a maxBytes bound", async function () {
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(testing.str);
+            void (await sentPromise);
+
+            const first = testing.netLink.receive(4);
+            expect(first?.length).to.equal(4);
+            const rest = testing.netLink.receive();
+            expect(`${String(first)}${String(rest)}`).to.equal(testing.str);
+            expect(() => testing.netLink.receive(0)).to.throw(RangeError);
+        });
+
+        it("can receiveMessages with length prefixes", async function () {
+            const payloads = [testing.str, "", "short"].map((str) =>
+                Buffer.from(str),
+            );
+            const frames = Buffer.concat(
+                payloads.map((payload) => {
+                    const prefix = Buffer.alloc(4);
+                    prefix.writeUInt32BE(payload.length, 0);
+                    return Buffer.concat([prefix, payload]);
+                }),
+            );
+            testing.netLink.setFraming("uint32be");
+
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(frames);
+            void (await sentPromise);
+
+            const first = testing.netLink.receiveMessages(1);
+            expect(first?.map(String)).to.deep.equal([testing.str]);
+
+            const rest = testing.netLink.receiveMessages(undefined, true);
+            expect(rest?.data.toString()).to.equal("short");
+            expect(Array.from(rest?.offsets || [])).to.deep.equal([0, 0, 5]);
+        });
+
+        it("can receive what framing left buffered first", async function () {
+            testing.netLink.readAhead = 4096;
+            testing.netLink.setFraming("uint8");
+
+            let sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(Buffer.from("\u0001atail"));
+            void (await sentPromise);
+
+            const messages = testing.netLink.receiveMessages(1);
+            expect(messages?.map(String)).to.deep.equal(["a"]);
+
+            sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send("more");
+            void (await sentPromise);
+
+            // the buffered "tail" comes first, then the socket's data
+            let received = String(testing.netLink.receive());
+            expect(received.startsWith("tail")).to.be.true;
+            while (received.length < "tailmore".length) {
+                received += String(testing.netLink.receive());
+            }
+            expect(received).to.equal("tailmore");
+        });
+
+        it("cannot receiveMessages without framing", function () {
+            expect(() => testing.netLink.receiveMessages()).to.throw();
+            expect(() =>
+                testing.netLink.setFraming(badArg<"none">()),
+            ).to.throw(TypeError);
+        });
+
+        it("cannot receive zero messages", function () {
+            testing.netLink.setFraming("uint8");
+            expect(() => testing.netLink.receiveMessages(0)).to.throw(
+                RangeError,
+            );
+        });
+
+        it("can receiveUntil a delimiter", async function () {
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(`${testing.str}\r\n\r\nafter`);
+            void (await sentPromise);
+
+            const read = testing.netLink.receiveUntil("\r\n\r\n");
+            expect(read?.toString()).to.equal(testing.str);
+            expect(testing.netLink.receive()?.toString()).to.equal("after");
+        });
+
+        it("cannot receiveUntil beyond maxBytes", async function () {
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(testing.str);
+            void (await sentPromise);
+
+            expect(() => testing.netLink.receiveUntil("\0", 4)).to.throw();
+            expect(testing.netLink.receive()?.toString()).to.equal(
+                testing.str,
+            );
+        });
+
+        it("can receiveLines", async function () {
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(`${testing.str}\nsecond\r\npartial`);
+            void (await sentPromise);
+
+            const lines = testing.netLink.receiveLines();
+            expect(lines).to.deep.equal([testing.str, "second"]);
+
+            testing.netLink.isBlocking = false;
+            expect(testing.netLink.receiveLines()).to.be.undefined;
+            expect(testing.netLink.receive()?.toString()).to.equal("partial");
+        });
+
+        it("cannot receive zero lines", function () {
+            expect(() => testing.netLink.receiveLines(0)).to.throw(RangeError);
+        });
+
+        it("cannot receiveLines beyond maxBytes", async function () {
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(testing.str);
+            void (await sentPromise);
+
+            expect(() => testing.netLink.receiveLines(1, 4)).to.throw(
+                "Delimiter not found within maxBytes.",
+            );
+            expect(testing.netLink.receive()?.toString()).to.equal(
+                testing.str,
+            );
+        });
+
+        it("can read-ahead", async function () {
+            expect(testing.netLink.readAhead).to.equal(0);
+            testing.netLink.readAhead = 4096;
+            expect(testing.netLink.readAhead).to.equal(4096);
+
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(testing.str);
+            void (await sentPromise);
+
+            const buffer = Buffer.alloc(testing.str.length);
+            let read = 0;
+            while (read < buffer.length) {
+                read += testing.netLink.receiveInto(buffer, read, 1) || 0;
+            }
+            expect(buffer.toString()).to.equal(testing.str);
+            expect(testing.netLink.readAheadRefills).to.be.greaterThan(0);
+            expect(testing.netLink.readAheadBytesServed).to.equal(
+                testing.str.length,
+            );
+        });
+
+        it("cannot set invalid read-ahead", function () {
+            expect(() => {
+                testing.netLink.readAhead = badArg();
+            }).to.throw();
+            expect(() => {
+                testing.settableNetLink.readAheadRefills = badArg();
+            }).to.throw();
+        });
+
+        it("can send without copying", async function () {
+            if (process.platform !== "linux") {
+                this.skip(); // MSG_ZEROCOPY is Linux only
+            }
+
+            expect(testing.netLink.zeroCopy).to.be.false;
+            testing.netLink.zeroCopy = true;
+            testing.netLink.zeroCopyThreshold = 1;
+            expect(testing.netLink.zeroCopy).to.be.true;
+            expect(testing.netLink.zeroCopyThreshold).to.equal(1);
+
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(Buffer.from(testing.str));
+            const sent = await sentPromise;
+            expect(sent.str).to.equal(testing.str);
+            expect(testing.netLink.zeroCopySent).to.equal(1);
+
+            while (testing.netLink.zeroCopyCompleted < 1) {
+                await new Promise((resolve) => setTimeout(resolve, 1));
+            }
+            expect(testing.netLink.zeroCopyCopied).to.be.at.most(1);
+            expect(testing.netLink.receive()?.toString()).to.equal(testing.str);
+        });
+
+        it("cannot set invalid zero copy options", function () {
+            expect(() => {
+                testing.netLink.zeroCopy = badArg();
+            }).to.throw();
+            expect(() => {
+                testing.netLink.zeroCopyThreshold = badArg();
+            }).to.throw();
+            expect(() => {
+                testing.settableNetLink.zeroCopyCompleted = badArg();
+            }).to.throw();
+        });
+
+        it("can sendFile", async function () {
+            const path = join(tmpdir(), `netlinkwrapper-${testing.port}.txt`);
+            writeFileSync(path, testing.str);
+
+            try {
+                let sentPromise = testing.echo.events.sentData.once();
+                expect(testing.netLink.sendFile(path)).to.equal(
+                    testing.str.length,
+                );
+                let sent = await sentPromise;
+                expect(sent.str).to.equal(testing.str);
+
+                const fd = openSync(path, "r");
+                try {
+                    sentPromise = testing.echo.events.sentData.once();
+                    expect(testing.netLink.sendFile(fd, 1, 3)).to.equal(3);
+                    sent = await sentPromise;
+                    expect(sent.str).to.equal(testing.str.slice(1, 4));
+
+                    // nothing left to send past the end of the file
+                    expect(testing.netLink.sendFile(fd, 1e6)).to.equal(0);
+                } finally {
+                    closeSync(fd);
+                }
+            } finally {
+                unlinkSync(path);
+            }
+        });
+
+        it("cannot sendFile invalid files", function () {
+            expect(() => testing.netLink.sendFile(badArg())).to.throw(
+                TypeError,
+            );
+            expect(() =>
+                testing.netLink.sendFile(join(tmpdir(), "netlinkwrapper-none")),
+            ).to.throw();
+        });
+
+        it("can cork and uncork", async function () {
+            if (process.platform === "win32") {
+                this.skip(); // Windows has no TCP_CORK
+            }
+
+            expect(testing.netLink.isCorked).to.be.false;
+            testing.netLink.cork();
+            expect(testing.netLink.isCorked).to.be.true;
+
+            const sentPromise = testing.echo.events.sentData.once();
+            for (const char of testing.str) {
+                testing.netLink.send(char);
+            }
+            testing.netLink.uncork();
+            expect(testing.netLink.isCorked).to.be.false;
+            const sent = await sentPromise;
+            expect(sent.str).to.equal(testing.str);
+        });
+
+        it("can send with more to follow", async function () {
+            const half = Math.floor(testing.str.length / 2);
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(testing.str.slice(0, half), { more: true });
+            testing.netLink.send(testing.str.slice(half));
+            const sent = await sentPromise;
+            expect(sent.str).to.equal(testing.str);
+        });
+
+        it("cannot send with invalid options", function () {
+            expect(() => testing.netLink.send(testing.str, badArg())).to.throw(
+                TypeError,
+            );
+            expect(() =>
+                testing.netLink.send(testing.str, { more: badArg() }),
+            ).to.throw(TypeError);
+        });
+
+        it("can queue data a non-blocking send left", async function () {
+            expect(testing.netLink.writeQueue).to.be.false;
+            testing.netLink.writeQueue = true;
+            expect(testing.netLink.writeQueue).to.be.true;
+            testing.netLink.isBlocking = false;
+
+            // more than the send buffer can hold, so some of it is queued
+            const data = Buffer.alloc(16 * 1024 * 1024, testing.str);
+            let received = 0;
+            testing.echo.events.sentData.on((sent) => {
+                received += sent.buffer.length;
+            });
+
+            const sent = testing.netLink.send(data);
+            expect(sent).to.be.lessThan(data.length);
+            expect(sent + testing.netLink.writeQueueSize).to.equal(data.length);
+
+            while (testing.netLink.flush() > 0) {
+                await new Promise((resolve) => setTimeout(resolve, 1));
+            }
+            expect(testing.netLink.writeQueueSize).to.equal(0);
+            while (received < data.length) {
+                await new Promise((resolve) => setTimeout(resolve, 1));
+            }
+            expect(received).to.equal(data.length);
+        });
+
+        it("cannot set invalid writeQueue", function () {
+            expect(() => {
+                testing.netLink.writeQueue = badArg();
+            }).to.throw();
+            expect(() => {
+                testing.settableNetLink.writeQueueSize = badArg();
+            }).to.throw();
+        });
+
+        it("can receiveString", async function () {
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(testing.str);
+            void (await sentPromise);
+
+            let str = "";
+            while (str.length < testing.str.length) {
+                str += testing.netLink.receiveString() || "";
+            }
+            expect(str).to.equal(testing.str);
+        });
+
+        it("can receiveString UTF-8 split between receives", async function () {
+            const buffer = Buffer.from("\u20ac\u{1f600}");
+            let sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(buffer.slice(0, 2));
+            void (await sentPromise);
+
+            testing.netLink.isBlocking = false;
+            expect(testing.netLink.receiveString()).to.be.undefined;
+
+            sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(buffer.slice(2, 5));
+            void (await sentPromise);
+            expect(testing.netLink.receiveString()).to.equal("\u20ac");
+
+            sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(buffer.slice(5));
+            void (await sentPromise);
+            expect(testing.netLink.receiveString("utf8")).to.equal(
+                "\u{1f600}",
+            );
+        });
+
+        it("cannot receiveString invalid encodings", function () {
+            expect(() => testing.netLink.receiveString(badArg())).to.throw(
+                TypeError,
+            );
+        });
+
+        it("can receiveInto Buffers", async function () {
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send(testing.str);
+            void (await sentPromise);
+
+            const buffer = Buffer.alloc(testing.str.length + 4);
+            const read = testing.netLink.receiveInto(buffer, 4);
+            expect(read).to.equal(testing.str.length);
+            expect(buffer.slice(4).toString()).to.equal(testing.str);
+        });
+
+        it("can receiveInto nothing", function () {
+            testing.netLink.isBlocking = false;
+            const read = testing.netLink.receiveInto(Buffer.alloc(8));
+            expect(read).to.be.undefined;
+        });
+
+        it("cannot receiveInto out of range", function () {
+            const buffer = Buffer.alloc(8);
+            expect(() => testing.netLink.receiveInto(buffer, 9)).to.throw(
+                RangeError,
+            );
+            expect(() => testing.netLink.receiveInto(buffer, 4, 5)).to.throw(
+                RangeError,
+            );
+            expect(() => testing.netLink.receiveInto(badArg())).to.throw(
+                TypeError,
+            );
+        });
     });
 });
@@ -1,6 +1,7 @@
 import { TextEncoder } from "util";
 import { expect } from "chai";
-import { udpTester, getNextTestingPort } from "./utils";
+import { Endpoint, SocketUDP } from "../lib";
+import { badArg, udpTester, getNextTestingPort } from "./utils";
 
 describe("UDP specific tests", function () {
     udpTester.testPermutations((testing) => {
@@ -21,6 +22,193 @@ describe("UDP specific tests", function () {
             expect(read?.data.toString()).to.equal(testing.str);
         });
 
+        it("can receiveFrom datagrams over 255 bytes", async function () {
+            const str = testing.str.padEnd(1024, "x");
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.sendTo(testing.host, testing.echo.getPort(), str);
+            void (await sentPromise);
+            const read = testing.netLink.receiveFrom();
+
+            expect(read).to.exist;
+            expect(read?.data.toString()).to.equal(str);
+            expect(read?.truncated).to.be.false;
+        });
+
+        it("can receiveFrom truncated datagrams", async function () {
+            testing.netLink.maxDatagramSize = 4;
+            expect(testing.netLink.maxDatagramSize).to.equal(4);
+
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.sendTo(
+                testing.host,
+                testing.echo.getPort(),
+                testing.str,
+            );
+            void (await sentPromise);
+            const read = testing.netLink.receiveFrom();
+
+            expect(read).to.exist;
+            expect(read?.data.toString()).to.equal(testing.str.slice(0, 4));
+            expect(read?.truncated).to.be.true;
+        });
+
+        it("cannot set invalid maxDatagramSize", function () {
+            expect(() => {
+                testing.netLink.maxDatagramSize = 0;
+            }).to.throw(RangeError);
+            expect(() => {
+                testing.netLink.maxDatagramSize = badArg();
+            }).to.throw(RangeError);
+        });
+
+        it("can cache source hosts", async function () {
+            expect(testing.netLink.addressCacheSize).to.be.greaterThan(0);
+            const hosts: (string | undefined)[] = [];
+            for (let i = 0; i < 2; i++) {
+                const sentPromise = testing.echo.events.sentData.once();
+                testing.netLink.sendTo(
+                    testing.host,
+                    testing.echo.getPort(),
+                    testing.str,
+                );
+                void (await sentPromise);
+                hosts.push(testing.netLink.receiveFrom()?.host);
+            }
+
+            expect(hosts[0]).to.exist;
+            expect(hosts[1]).to.equal(hosts[0]);
+            expect(testing.netLink.addressCacheMisses).to.equal(1);
+            expect(testing.netLink.addressCacheHits).to.equal(1);
+        });
+
+        it("cannot set invalid addressCacheSize", function () {
+            expect(() => {
+                testing.netLink.addressCacheSize = badArg();
+            }).to.throw();
+            expect(() => {
+                testing.settableNetLink.addressCacheHits = badArg();
+            }).to.throw();
+        });
+
+        it("can receiveFrom strings", async function () {
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.sendTo(
+                testing.host,
+                testing.echo.getPort(),
+                testing.str,
+            );
+            void (await sentPromise);
+            const read = testing.netLink.receiveFrom("utf8");
+
+            expect(read).to.exist;
+            expect(read?.data).to.equal(testing.str);
+        });
+
+        it("can receiveFromInto Uint8Arrays", async function () {
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.sendTo(
+                testing.host,
+                testing.echo.getPort(),
+                testing.str,
+            );
+            void (await sentPromise);
+            const array = new Uint8Array(testing.str.length);
+            const read = testing.netLink.receiveFromInto(array);
+
+            expect(read).to.exist;
+            expect(read?.port).to.equal(testing.echo.getPort());
+            expect(read?.bytesRead).to.equal(testing.str.length);
+            expect(Buffer.from(array).toString()).to.equal(testing.str);
+        });
+
+        it("can receiveFromMany datagrams", async function () {
+            const strs = [testing.str, "second", "third datagram"];
+            for (const str of strs) {
+                const sentPromise = testing.echo.events.sentData.once();
+                testing.netLink.sendTo(
+                    testing.host,
+                    testing.echo.getPort(),
+                    str,
+                );
+                void (await sentPromise);
+            }
+
+            const isIPv4 = testing.ipVersion === "IPv4";
+            const received: string[] = [];
+            while (received.length < strs.length) {
+                const read = testing.netLink.receiveFromMany(8, 1024);
+                expect(read).to.exist;
+                if (!read) {
+                    break;
+                }
+
+                expect(read.offsets.length).to.equal(read.lengths.length + 1);
+                for (let i = 0; i < read.lengths.length; i++) {
+                    const start = read.offsets[i];
+                    received.push(
+                        read.data
+                            .slice(start, start + read.lengths[i])
+                            .toString(),
+                    );
+                    expect(read.ports[i]).to.equal(testing.echo.getPort());
+                    expect(read.addresses[read.addressIndices[i]]).to.equal(
+                        isIPv4 ? "127.0.0.1" : "::1",
+                    );
+                }
+            }
+
+            expect(received).to.deep.equal(strs);
+        });
+
+        it("cannot receiveFromMany with invalid args", function () {
+            expect(() => testing.netLink.receiveFromMany(0, 1)).to.throw(
+                RangeError,
+            );
+            expect(() => testing.netLink.receiveFromMany(1, 0)).to.throw(
+                RangeError,
+            );
+            expect(() =>
+                testing.netLink.receiveFromMany(badArg(), badArg()),
+            ).to.throw(TypeError);
+        });
+
+        it("can receiveFromRaw into reusable arrays", async function () {
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.sendTo(
+                testing.host,
+                testing.echo.getPort(),
+                testing.str,
+            );
+            void (await sentPromise);
+            const buffer = Buffer.alloc(testing.str.length + 8);
+            const info = new Uint32Array(7);
+            const read = testing.netLink.receiveFromRaw(buffer, info);
+
+            expect(read).to.equal(testing.str.length);
+            expect(buffer.toString("utf8", 0, read)).to.equal(testing.str);
+            expect(info[0]).to.equal(testing.echo.getPort());
+            expect(info[2]).to.equal(0);
+            if (testing.ipVersion === "IPv4") {
+                expect(info[1]).to.equal(4);
+                expect(info[3]).to.equal(0x7f000001);
+            } else {
+                expect(info[1]).to.equal(6);
+                expect(Array.from(info.slice(3))).to.deep.equal([0, 0, 0, 1]);
+            }
+
+            testing.netLink.isBlocking = false;
+            expect(testing.netLink.receiveFromRaw(buffer, info)).to.equal(-1);
+        });
+
+        it("cannot receiveFromRaw into small info arrays", function () {
+            expect(() =>
+                testing.netLink.receiveFromRaw(
+                    Buffer.alloc(1),
+                    new Uint32Array(1),
+                ),
+            ).to.throw(RangeError);
+        });
+
         it("can receiveFrom nothing", function () {
             testing.netLink.isBlocking = false;
             const readFromNothing = testing.netLink.receiveFrom();
@@ -40,6 +228,175 @@ describe("UDP specific tests", function () {
             expect(sent.str).to.equal(testing.str);
         });
 
+        it("can sendToMany other UDP sockets", async function () {
+            const strs = [testing.str, "second", "third datagram"];
+            const sentStrs: string[] = [];
+            const allSent = new Promise<void>((resolve) => {
+                testing.echo.events.sentData.on((sent) => {
+                    sentStrs.push(sent.str);
+                    if (sentStrs.length === strs.length) {
+                        resolve();
+                    }
+                });
+            });
+
+            const sentCount = testing.netLink.sendToMany(
+                strs.map((str, i) => ({
+                    host: testing.host,
+                    port: testing.echo.getPort(),
+                    data: i % 2 ? Buffer.from(str) : str,
+                })),
+            );
+            expect(sentCount).to.equal(strs.length);
+
+            void (await allSent);
+            expect(sentStrs).to.deep.equal(strs);
+        });
+
+        it("can sendToMany payloads to one address", async function () {
+            const strs = [testing.str, "second"];
+            const sentStrs: string[] = [];
+            const allSent = new Promise<void>((resolve) => {
+                testing.echo.events.sentData.on((sent) => {
+                    sentStrs.push(sent.str);
+                    if (sentStrs.length === strs.length) {
+                        resolve();
+                    }
+                });
+            });
+
+            const sentCount = testing.netLink.sendToMany(
+                testing.host,
+                testing.echo.getPort(),
+                strs,
+            );
+            expect(sentCount).to.equal(strs.length);
+
+            void (await allSent);
+            expect(sentStrs).to.deep.equal(strs);
+        });
+
+        it("can sendToSegmented other UDP sockets", async function () {
+            const strs = ["first", "secon", "third"];
+            const sentStrs: string[] = [];
+            const allSent = new Promise<void>((resolve) => {
+                testing.echo.events.sentData.on((sent) => {
+                    sentStrs.push(sent.str);
+                    if (sentStrs.length === strs.length) {
+                        resolve();
+                    }
+                });
+            });
+
+            testing.netLink.sendToSegmented(
+                testing.host,
+                testing.echo.getPort(),
+                strs.join(""),
+                5,
+            );
+
+            void (await allSent);
+            expect(sentStrs).to.deep.equal(strs);
+        });
+
+        it("cannot sendToSegmented with invalid segment sizes", function () {
+            expect(() =>
+                testing.netLink.sendToSegmented(
+                    testing.host,
+                    testing.echo.getPort(),
+                    testing.str,
+                    0,
+                ),
+            ).to.throw(RangeError);
+        });
+
+        it("cannot sendToMany invalid messages", function () {
+            expect(() => testing.netLink.sendToMany(badArg())).to.throw(
+                TypeError,
+            );
+            expect(() =>
+                testing.netLink.sendToMany([
+                    { host: testing.host, port: badArg(), data: "" },
+                ]),
+            ).to.throw(TypeError);
+        });
+
+        it("can send to Endpoints", async function () {
+            const endpoint = new Endpoint(
+                testing.host,
+                testing.echo.getPort(),
+                testing.ipVersion,
+            );
+            const strs = ["sendTo", "sendToMany", "messages", "segmented"];
+            const sentStrs: string[] = [];
+            const allSent = new Promise<void>((resolve) => {
+                testing.echo.events.sentData.on((sent) => {
+                    sentStrs.push(sent.str);
+                    if (sentStrs.length === strs.length) {
+                        resolve();
+                    }
+                });
+            });
+
+            testing.netLink.sendTo(endpoint, strs[0]);
+            testing.netLink.sendToMany(endpoint, [strs[1]]);
+            testing.netLink.sendToMany([{ endpoint, data: strs[2] }]);
+            testing.netLink.sendToSegmented(endpoint, strs[3], 64);
+
+            void (await allSent);
+            expect(sentStrs).to.deep.equal(strs);
+        });
+
+        it("cannot send to Endpoints of the other IP version", function () {
+            const isIPv4 = testing.ipVersion === "IPv4";
+            const endpoint = isIPv4
+                ? new Endpoint("::1", testing.echo.getPort(), "IPv6")
+                : new Endpoint("127.0.0.1", testing.echo.getPort(), "IPv4");
+
+            expect(() => testing.netLink.sendTo(endpoint, "")).to.throw(Error);
+            expect(() =>
+                testing.netLink.sendToMany([{ endpoint, data: "" }]),
+            ).to.throw(Error);
+        });
+
+        it("can send and receive once connected", async function () {
+            expect(testing.netLink.isConnected).to.be.false;
+            testing.netLink.connect(testing.host, testing.echo.getPort());
+            expect(testing.netLink.isConnected).to.be.true;
+            expect(testing.netLink.portTo).to.equal(testing.echo.getPort());
+
+            const sentPromise = testing.echo.events.sentData.once();
+            expect(testing.netLink.send(testing.str)).to.equal(
+                Buffer.byteLength(testing.str),
+            );
+            void (await sentPromise);
+
+            const read = testing.netLink.receive();
+            expect(read?.data.toString()).to.equal(testing.str);
+            expect(read?.truncated).to.be.false;
+        });
+
+        it("flags truncated datagrams once connected", async function () {
+            testing.netLink.connect(testing.host, testing.echo.getPort());
+            testing.netLink.maxDatagramSize = 4;
+
+            const sentPromise = testing.echo.events.sentData.once();
+            testing.netLink.send("truncate me");
+            void (await sentPromise);
+
+            const read = testing.netLink.receive();
+            expect(read?.data.toString()).to.equal("trun");
+            expect(read?.truncated).to.be.true;
+        });
+
+        it("cannot send before connecting", function () {
+            expect(() => testing.netLink.send(testing.str)).to.throw(Error);
+            expect(() => testing.netLink.receive()).to.throw(Error);
+            expect(() => testing.netLink.connect(badArg(), 1)).to.throw(
+                TypeError,
+            );
+        });
+
         it("can sendTo with Buffers", async function () {
             const sentPromise = testing.echo.events.sentData.once();
             const buffer = Buffer.from(testing.str);
@@ -76,4 +433,21 @@ describe("UDP specific tests", function () {
             ).not.to.throw();
         });
     });
+
+    it("can be connected on construction", function () {
+        const receiver = new SocketUDP(undefined, "127.0.0.1");
+        const sender = new SocketUDP(undefined, "127.0.0.1", "IPv4", {
+            host: "127.0.0.1",
+            port: receiver.portFrom,
+        });
+        expect(sender.isConnected).to.be.true;
+
+        sender.send("connected");
+        const read = receiver.receiveFrom();
+        expect(read?.port).to.equal(sender.portFrom);
+        expect(read?.data.toString()).to.equal("connected");
+
+        sender.disconnect();
+        receiver.disconnect();
+    });
 });
@@ -1,6 +1,7 @@
 export * from "./bad-arg";
 export * from "./echo-socket";
 export * from "./permutations";
+export * from "./saturated-listener";
 export * from "./tester";
 export * from "./tester.tcp-client";
 export * from "./tester.tcp-server";
@@ -0,0 +1,49 @@
+import { SocketClientTCP, SocketServerTCP } from "../../lib";
+import { getNextTestingPort } from "./tester";
+
+/**
+ * A TCP listener that never accepts, with its accept queue filled so that
+ * further connects to it neither complete nor fail, but hang until they
+ * time out.
+ */
+export class SaturatedListenerTCP {
+    public readonly host = "127.0.0.1";
+    public readonly port = getNextTestingPort();
+
+    private readonly server = new SocketServerTCP(this.port, this.host);
+    private readonly clients: SocketClientTCP[] = [];
+
+    /**
+     * Connects to the listener until a connect times out.
+     *
+     * @returns True once connects hang, false if the operating system
+     * refuses them instead when the queue is full.
+     */
+    public saturate(): boolean {
+        for (let i = 0; i < 1024; i += 1) {
+            try {
+                this.clients.push(
+                    new SocketClientTCP(this.port, this.host, "IPv4", 100),
+                );
+            } catch (err: unknown) {
+                return (
+                    err instanceof Error &&
+                    err.message.includes("timed out connecting")
+                );
+            }
+        }
+
+        return false;
+    }
+
+    /** Disconnects every client, then the listener itself. */
+    public close(): void {
+        for (const client of this.clients.splice(0)) {
+            client.disconnect();
+        }
+
+        if (!this.server.isDestroyed) {
+            this.server.disconnect();
+        }
+    }
+}